@@ -9,11 +9,13 @@ UAbilityTask_WaitForProjectileHit::UAbilityTask_WaitForProjectileHit(const FObje
 
 }
 
-void UAbilityTask_WaitForProjectileHit::OnDestroyed(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+void UAbilityTask_WaitForProjectileHit::OnResolved(AProjectile* Projectile, bool bHitTarget)
 {
-	if (Actor == Cast<AActor>(MyProjectile)) 
+	if (Projectile == MyProjectile) 
 	{
-		// Projectile was destroyed
+		// Projectile hit or expired. It may be reused by the pool, so let go of it now.
+		MyProjectile->OnProjectileResolved.RemoveDynamic(this, &UAbilityTask_WaitForProjectileHit::OnResolved);
+		MyProjectile = nullptr;
 		if (ShouldBroadcastAbilityTaskDelegates()) {
 			OnProjectileHit.Broadcast();
 		}
@@ -36,7 +38,7 @@ void UAbilityTask_WaitForProjectileHit::Activate()
 {
 	if (MyProjectile) 
 	{
-		MyProjectile->OnEndPlay.AddDynamic(this, &UAbilityTask_WaitForProjectileHit::OnDestroyed);
+		MyProjectile->OnProjectileResolved.AddDynamic(this, &UAbilityTask_WaitForProjectileHit::OnResolved);
 	}
 }
 
@@ -45,6 +47,6 @@ void UAbilityTask_WaitForProjectileHit::OnDestroy(bool AbilityIsEnding)
 	Super::OnDestroy(AbilityIsEnding);
 	if (MyProjectile)
 	{
-		MyProjectile->OnEndPlay.RemoveDynamic(this, &UAbilityTask_WaitForProjectileHit::OnDestroyed);
+		MyProjectile->OnProjectileResolved.RemoveDynamic(this, &UAbilityTask_WaitForProjectileHit::OnResolved);
 	}
 }
\ No newline at end of file
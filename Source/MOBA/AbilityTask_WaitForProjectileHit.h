@@ -26,7 +26,7 @@ class MOBA_API UAbilityTask_WaitForProjectileHit : public UAbilityTask
 		AProjectile* MyProjectile;
 
 	UFUNCTION()
-		void OnDestroyed(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+		void OnResolved(AProjectile* Projectile, bool bHitTarget);
 
 	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (DisplayName = "WaitForProjectileHit", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
 		static UAbilityTask_WaitForProjectileHit* WaitForProjectileHit(UGameplayAbility* OwningAbility, AProjectile* SourceProjectile);
@@ -2,6 +2,8 @@
 
 
 #include "AbilityTask_WaitInRangeForAbility.h"
+#include "MOBAGameplayAbility.h"
+#include "MOBARangeWatchSubsystem.h"
 
 UAbilityTask_WaitInRangeForAbility::UAbilityTask_WaitInRangeForAbility(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -9,23 +11,26 @@ UAbilityTask_WaitInRangeForAbility::UAbilityTask_WaitInRangeForAbility(const FOb
 	
 }
 
-void UAbilityTask_WaitInRangeForAbility::OverlapHandle(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult) 
+void UAbilityTask_WaitInRangeForAbility::OnInRangeReached() 
 {
-	AMOBACharacter* Target = Cast<AMOBACharacter>(OtherActor);
-	// Check if the OtherActor is our Target
-	if (TargetCharacter == Target)
-	{	
-		if (OtherComp == Cast<UPrimitiveComponent>(Target->GetMesh())) 
-		{
-			AIController->StopMovement();
-			// We found the target, broadcast the delegate and end the task
-			if (ShouldBroadcastAbilityTaskDelegates()) {
-				OnInRange.Broadcast();
-			}
-			EndTask();
-		}
-		
+	RangeWatchHandle = INDEX_NONE;
+	if (AIController) AIController->StopMovement();
+	// We reached the target, broadcast the delegate and end the task
+	if (ShouldBroadcastAbilityTaskDelegates()) {
+		OnInRange.Broadcast();
 	}
+	EndTask();
+}
+
+void UAbilityTask_WaitInRangeForAbility::OnWatchCancelled()
+{
+	RangeWatchHandle = INDEX_NONE;
+	if (IsValid(AIController)) AIController->StopMovement();
+	// The target is gone and will never come in range
+	if (ShouldBroadcastAbilityTaskDelegates()) {
+		OnTargetLost.Broadcast();
+	}
+	EndTask();
 }
 
 UAbilityTask_WaitInRangeForAbility* UAbilityTask_WaitInRangeForAbility::WaitInRangeForTargetedAbility(UGameplayAbility * OwningAbility, AMOBACharacter* Source, AMOBACharacter* Target, USphereComponent* InSphere, FVector InLocation)
@@ -47,9 +52,15 @@ void UAbilityTask_WaitInRangeForAbility::InitSimulatedTask(UGameplayTasksCompone
 
 void UAbilityTask_WaitInRangeForAbility::Activate()
 {
-	if (RangeSphere)
+	// Range comes from the ability, the sphere's radius is only a fallback for non MOBA abilities
+	const UMOBAGameplayAbility* MOBAAbility = Cast<UMOBAGameplayAbility>(Ability);
+	const float Range = MOBAAbility ? MOBAAbility->AbilityRange : (RangeSphere ? RangeSphere->GetScaledSphereRadius() : 0.0f);
+	UMOBARangeWatchSubsystem* RangeWatchSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMOBARangeWatchSubsystem>() : nullptr;
+	if (RangeWatchSubsystem && SourceCharacter)
 	{
-		RangeSphere->OnComponentBeginOverlap.AddDynamic(this, &UAbilityTask_WaitInRangeForAbility::OverlapHandle);
+		RangeWatchHandle = RangeWatchSubsystem->AddWatch(SourceCharacter, TargetCharacter, TargetLocation, Range,
+			FMOBARangeWatchDelegate::CreateUObject(this, &UAbilityTask_WaitInRangeForAbility::OnInRangeReached),
+			FMOBARangeWatchDelegate::CreateUObject(this, &UAbilityTask_WaitInRangeForAbility::OnWatchCancelled));
 	}
 	AIController = Cast<AAIController>(SourceCharacter->GetController());
 	if (AIController) 
@@ -69,12 +80,14 @@ void UAbilityTask_WaitInRangeForAbility::Activate()
 
 void UAbilityTask_WaitInRangeForAbility::OnDestroy(bool AbilityIsEnding)
 {
-	Super::OnDestroy(AbilityIsEnding);
-	if (RangeSphere)
+	UMOBARangeWatchSubsystem* RangeWatchSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMOBARangeWatchSubsystem>() : nullptr;
+	if (RangeWatchSubsystem && RangeWatchHandle != INDEX_NONE)
 	{
-		RangeSphere->OnComponentBeginOverlap.RemoveDynamic(this, &UAbilityTask_WaitInRangeForAbility::OverlapHandle);
+		RangeWatchSubsystem->RemoveWatch(RangeWatchHandle);
+		RangeWatchHandle = INDEX_NONE;
 	}
 	ClearWaitingOnAvatar();
+	Super::OnDestroy(AbilityIsEnding);
 }
 
 FString UAbilityTask_WaitInRangeForAbility::GetDebugString() const
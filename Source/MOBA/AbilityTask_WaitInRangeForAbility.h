@@ -26,6 +26,10 @@ class MOBA_API UAbilityTask_WaitInRangeForAbility : public UAbilityTask
 	UPROPERTY(BlueprintAssignable)
 		FWaitInRangeForAbility OnInRange;
 
+	// Source or target was destroyed before coming in range. The task has ended.
+	UPROPERTY(BlueprintAssignable)
+		FWaitInRangeForAbility OnTargetLost;
+
 	FString GetDebugString() const override;
 
 	AMOBACharacter* SourceCharacter;
@@ -34,8 +38,11 @@ class MOBA_API UAbilityTask_WaitInRangeForAbility : public UAbilityTask
 	AAIController* AIController;
 	FVector TargetLocation = FVector{ 0.0f,0.0f,0.0f };
 
-	UFUNCTION()
-	void OverlapHandle(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult);
+	// Watch registered with UMOBARangeWatchSubsystem while the task is active
+	int32 RangeWatchHandle = INDEX_NONE;
+
+	void OnInRangeReached();
+	void OnWatchCancelled();
 	
 	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (DisplayName = "WaitForInRange", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
 		static UAbilityTask_WaitInRangeForAbility* WaitInRangeForTargetedAbility(UGameplayAbility* OwningAbility, AMOBACharacter* Source, AMOBACharacter* Target, USphereComponent* InSphere, FVector InLocation);
@@ -4,6 +4,7 @@
 #include "BasicAttackCooldownMainHand.h"
 #include "MOBAAttributeSet.h"
 #include "MOBACharacter.h"
+#include "MOBACombatFormulas.h"
 #include "GameplayEffect.h"
 #include "GameplayEffectExecutionCalculation.h"
 
@@ -20,7 +21,7 @@ float UBasicAttackCooldownMainHand::CalculateBaseMagnitude_Implementation(const
 		if (MyCharacter) // Main hand attack speed * bonus attack speed multiplier, converted to time
 		{
 			// Check if the character is dual-wielding, add 15% attack speed bonus if so.			
-			return (1 / (MyCharacter->AttributeSet->MainHandAttackSpeed.GetCurrentValue() * (1 + MyCharacter->AttributeSet->BonusAttackSpeed.GetCurrentValue())));
+			return FMOBACombatFormulas::AttackInterval(MyCharacter->AttributeSet->MainHandAttackSpeed.GetCurrentValue(), MyCharacter->AttributeSet->BonusAttackSpeed.GetCurrentValue());
 		}
 		else return 0.0f;
 	}
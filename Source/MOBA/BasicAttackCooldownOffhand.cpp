@@ -4,6 +4,7 @@
 #include "BasicAttackCooldownOffhand.h"
 #include "MOBAAttributeSet.h"
 #include "MOBACharacter.h"
+#include "MOBACombatFormulas.h"
 #include "GameplayEffect.h"
 #include "GameplayEffectExecutionCalculation.h"
 
@@ -19,7 +20,7 @@ float UBasicAttackCooldownOffhand::CalculateBaseMagnitude_Implementation(const F
 		AMOBACharacter* MyCharacter = Cast<AMOBACharacter>(AbilitySystem->GetOwner());
 		if (MyCharacter) // Main hand attack speed * bonus attack speed multiplier, converted to time
 		{
-			return (1 / (MyCharacter->AttributeSet->OffHandAttackSpeed.GetCurrentValue() * (1 + MyCharacter->AttributeSet->BonusAttackSpeed.GetCurrentValue())*1.15f));
+			return FMOBACombatFormulas::AttackInterval(MyCharacter->AttributeSet->OffHandAttackSpeed.GetCurrentValue(), MyCharacter->AttributeSet->BonusAttackSpeed.GetCurrentValue(), FMOBACombatFormulas::DualWieldAttackSpeedMultiplier);
 		}
 		else return 0.0f;
 	}
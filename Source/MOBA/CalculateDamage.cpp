@@ -102,22 +102,10 @@ void UCalculateDamage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	FGameplayEffectContextHandle Handle = Spec.GetContext();
 	const UGameplayAbility* SourceAbility = Handle.GetAbility();
 	const UMOBAGameplayAbility* MOBASourceAbility = Cast<UMOBAGameplayAbility>(SourceAbility);
-	UClass* AbilityData;
-	UMOBAAbilityData* MOBAAbilityData;
-	bool bIsHealthRegen = false;
-
-	if (MOBASourceAbility) 
-	{
-		AbilityData = MOBASourceAbility->AbilityData;
-		UObject* AbilityDataObj = AbilityData->ClassDefaultObject;
-		MOBAAbilityData = Cast<UMOBAAbilityData>(AbilityDataObj);
-		if (!MOBAAbilityData) return;
-		if (MOBAAbilityData->GetFName() == FName("Default__BP_AD_HealthRegen_C")) 
-		{
-			bIsHealthRegen = true;
-		}
-	}
-	else return;
+	if (!MOBASourceAbility) return;
+	// Precompiled per ability data class, no CDO access or name checks per execution
+	const FMOBADamageRecipe Recipe = UMOBAAbilityData::GetDamageRecipe(MOBASourceAbility->AbilityData);
+	if (Recipe.Kind == EMOBARecipeKind::None) return;
 
 	// Get Source and target data
 	UAbilitySystemComponent* TargetAbilitySystemComponent = ExecutionParams.GetTargetAbilitySystemComponent();
@@ -170,43 +158,67 @@ void UCalculateDamage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	float MainHandMaxDamage = 0.f;
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Source().MainHandMaxDamageDef, EvaluationParameters, MainHandMaxDamage);
 	float OffHandMinDamage = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Source().MainHandMinDamageDef, EvaluationParameters, OffHandMinDamage);
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Source().OffHandMinDamageDef, EvaluationParameters, OffHandMinDamage);
 	float OffHandMaxDamage = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Source().MainHandMaxDamageDef, EvaluationParameters, OffHandMaxDamage);
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Source().OffHandMaxDamageDef, EvaluationParameters, OffHandMaxDamage);
 
 	// --------------------------------------
 	//	Damage Done
 	//	
 	// --------------------------------------
 
-	float DamageDone = 0.0f;
-	float HealingDone = 0.0f;
-	switch (MOBAAbilityData->DamageType) 
-	{
-	case EMOBADamageType::Physical: DamageDone = (MOBAAbilityData->BaseValue + MOBAAbilityData->AttackPowerRatio * AttackPower + MOBAAbilityData->SpellPowerRatio * SpellPower) * (1 - PhysicalDamageReduction) * (1 - FlatDamageReduction);
-		break;
-	case EMOBADamageType::Environmental: DamageDone = (MOBAAbilityData->BaseValue + MOBAAbilityData->AttackPowerRatio * AttackPower + MOBAAbilityData->SpellPowerRatio * SpellPower) * (1 - EnvironmentalDamageReduction) * (1 - FlatDamageReduction);
-		break;
-	case EMOBADamageType::TrueDamage: DamageDone = (MOBAAbilityData->BaseValue + MOBAAbilityData->AttackPowerRatio * AttackPower + MOBAAbilityData->SpellPowerRatio * SpellPower) * (1 - FlatDamageReduction);
-		break;
-	case EMOBADamageType::Heal: if (bIsHealthRegen) 
+	FMOBADamageSourceSnapshot SourceSnapshot;
+	SourceSnapshot.AttackPower = AttackPower;
+	SourceSnapshot.SpellPower = SpellPower;
+	// Weapon roll and critical strike, keyed by the attacker's next attack index
+	AMOBACharacter* SourceCharacter = Cast<AMOBACharacter>(SourceActor);
+	if (SourceCharacter && Recipe.Kind == EMOBARecipeKind::Damage && Recipe.WeaponDamageType != EWeaponDamageType::None)
 	{
-		HealingDone = (HealthRegen / 5) * TargetHealingModifier;
+		RollWeaponDamage(Recipe, SourceCharacter->NextCombatRandom(), MainHandMinDamage, MainHandMaxDamage, OffHandMinDamage, OffHandMaxDamage, CriticalChance, CriticalDamage, SourceSnapshot);
 	}
-								else 
+	const float HealthDelta = CalculateHealthDelta(Recipe, CalculateRecipeValue(Recipe, SourceSnapshot), PhysicalDamageReduction, EnvironmentalDamageReduction, FlatDamageReduction, TargetHealingModifier, HealthRegen);
+	if (HealthDelta != 0.f)
 	{
-		HealingDone = (MOBAAbilityData->BaseValue + MOBAAbilityData->AttackPowerRatio * AttackPower + MOBAAbilityData->SpellPowerRatio * SpellPower) * (TargetHealingModifier);
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(Target().HealthProperty, EGameplayModOp::Additive, HealthDelta));
 	}
-		break;
-	default: break;
-	} 
+}
 
-	if (DamageDone > 0.f)
-	{
-		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(Target().HealthProperty, EGameplayModOp::Additive, -DamageDone));
-	}
-	if (HealingDone > 0.f) 
+FMOBADamageSourceSnapshot::FMOBADamageSourceSnapshot(const UMOBAAttributeSet& SourceAttributes)
+	: AttackPower(SourceAttributes.AttackPower.GetCurrentValue())
+	, SpellPower(SourceAttributes.SpellPower.GetCurrentValue())
+{}
+
+void FMOBADamageTargetBatch::Reserve(int32 Number)
+{
+	PhysicalDamageReduction.Reserve(Number);
+	EnvironmentalDamageReduction.Reserve(Number);
+	FlatDamageReduction.Reserve(Number);
+	HealingModifier.Reserve(Number);
+	HealthRegen.Reserve(Number);
+}
+
+void FMOBADamageTargetBatch::Add(const UMOBAAttributeSet& TargetAttributes)
+{
+	PhysicalDamageReduction.Add(TargetAttributes.PhysicalDamageReduction.GetCurrentValue());
+	EnvironmentalDamageReduction.Add(TargetAttributes.EnvironmentalDamageReduction.GetCurrentValue());
+	FlatDamageReduction.Add(TargetAttributes.FlatDamageReduction.GetCurrentValue());
+	HealingModifier.Add(TargetAttributes.HealingModifier.GetCurrentValue());
+	HealthRegen.Add(TargetAttributes.HealthRegen.GetCurrentValue());
+}
+
+void UCalculateDamage::CalculateHealthDeltas(const FMOBADamageRecipe& Recipe, const FMOBADamageSourceSnapshot& SourceSnapshot, const FMOBADamageTargetBatch& Targets, TArray<float>& OutHealthDeltas)
+{
+	const int32 NumTargets = Targets.Num();
+	const float RecipeValue = CalculateRecipeValue(Recipe, SourceSnapshot);
+	OutHealthDeltas.SetNumUninitialized(NumTargets);
+	const float* PhysicalDamageReduction = Targets.PhysicalDamageReduction.GetData();
+	const float* EnvironmentalDamageReduction = Targets.EnvironmentalDamageReduction.GetData();
+	const float* FlatDamageReduction = Targets.FlatDamageReduction.GetData();
+	const float* HealingModifier = Targets.HealingModifier.GetData();
+	const float* HealthRegen = Targets.HealthRegen.GetData();
+	float* HealthDeltas = OutHealthDeltas.GetData();
+	for (int32 Index = 0; Index < NumTargets; Index++)
 	{
-		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(Target().HealthProperty, EGameplayModOp::Additive, HealingDone));
+		HealthDeltas[Index] = CalculateHealthDelta(Recipe, RecipeValue, PhysicalDamageReduction[Index], EnvironmentalDamageReduction[Index], FlatDamageReduction[Index], HealingModifier[Index], HealthRegen[Index]);
 	}
-}
\ No newline at end of file
+}
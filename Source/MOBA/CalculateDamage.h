@@ -4,8 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "GameplayEffectExecutionCalculation.h"
+#include "MOBAGameplayAbility.h"
+#include "MOBACombatRandom.h"
+#include "MOBACombatFormulas.h"
+#include "CalculateHealing.h"
 #include "CalculateDamage.generated.h"
 
+class UMOBAAttributeSet;
+
+// Source side values a damage recipe scales with. Captured once and shared by every target of the same cast.
+struct FMOBADamageSourceSnapshot
+{
+	float AttackPower = 0.0f;
+	float SpellPower = 0.0f;
+	float WeaponDamage = 0.0f;			// Rolled weapon damage, filled by UCalculateDamage::RollWeaponDamage
+	float CriticalMultiplier = 1.0f;	// CriticalDamage when the attack crit, 1 otherwise
+
+	FMOBADamageSourceSnapshot() {}
+	explicit FMOBADamageSourceSnapshot(const UMOBAAttributeSet& SourceAttributes);
+};
+
+// Target side values for a batch of targets, one array per attribute
+struct FMOBADamageTargetBatch
+{
+	TArray<float> PhysicalDamageReduction;
+	TArray<float> EnvironmentalDamageReduction;
+	TArray<float> FlatDamageReduction;
+	TArray<float> HealingModifier;
+	TArray<float> HealthRegen;
+
+	void Reserve(int32 Number);
+	void Add(const UMOBAAttributeSet& TargetAttributes);
+	int32 Num() const { return FlatDamageReduction.Num(); }
+};
+
 /**
  * 
  */
@@ -16,4 +48,48 @@ class MOBA_API UCalculateDamage : public UGameplayEffectExecutionCalculation
 	
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
 
+public:
+	// Health change for one target, negative for damage and positive for healing. RecipeValue is base value plus source ratios.
+	static FORCEINLINE float CalculateHealthDelta(const FMOBADamageRecipe& Recipe, float RecipeValue, float PhysicalDamageReduction, float EnvironmentalDamageReduction, float FlatDamageReduction, float HealingModifier, float HealthRegen)
+	{
+		switch (Recipe.Kind)
+		{
+		case EMOBARecipeKind::Damage:
+			switch (Recipe.DamageType)
+			{
+			case EMOBADamageType::Physical: return -FMath::Max(FMOBACombatFormulas::MitigateDamage(RecipeValue, PhysicalDamageReduction, FlatDamageReduction), 0.0f);
+			case EMOBADamageType::Environmental: return -FMath::Max(FMOBACombatFormulas::MitigateDamage(RecipeValue, EnvironmentalDamageReduction, FlatDamageReduction), 0.0f);
+			case EMOBADamageType::TrueDamage: return -FMath::Max(FMOBACombatFormulas::MitigateDamage(RecipeValue, 0.0f, FlatDamageReduction), 0.0f);
+			default: return 0.0f;
+			}
+		case EMOBARecipeKind::Heal:
+		case EMOBARecipeKind::HealthRegen: return UCalculateHealing::CalculateHealAmount(Recipe, RecipeValue, HealingModifier, HealthRegen);
+		default: return 0.0f;
+		}
+	}
+
+	static FORCEINLINE float CalculateRecipeValue(const FMOBADamageRecipe& Recipe, const FMOBADamageSourceSnapshot& SourceSnapshot)
+	{
+		return (Recipe.BaseValue + Recipe.AttackPowerRatio * SourceSnapshot.AttackPower + Recipe.SpellPowerRatio * SourceSnapshot.SpellPower + SourceSnapshot.WeaponDamage) * SourceSnapshot.CriticalMultiplier;
+	}
+
+	// Weapon and critical strike stage for damage recipes with a weapon damage type. Rolls come from Random, so the result can be recomputed from its key.
+	static FORCEINLINE void RollWeaponDamage(const FMOBADamageRecipe& Recipe, const FMOBACombatRandom& Random, float MainHandMinDamage, float MainHandMaxDamage, float OffHandMinDamage, float OffHandMaxDamage, float CriticalChance, float CriticalDamage, FMOBADamageSourceSnapshot& SourceSnapshot)
+	{
+		// Heals never crit or add weapon damage
+		if (Recipe.Kind != EMOBARecipeKind::Damage || Recipe.WeaponDamageType == EWeaponDamageType::None) return;
+		SourceSnapshot.WeaponDamage = 0.0f;
+		if (Recipe.WeaponDamageType == EWeaponDamageType::MainHand || Recipe.WeaponDamageType == EWeaponDamageType::BothHands)
+		{
+			SourceSnapshot.WeaponDamage += Random.GetRange(EMOBACombatRoll::MainHandDamage, MainHandMinDamage, MainHandMaxDamage);
+		}
+		if (Recipe.WeaponDamageType == EWeaponDamageType::Offhand || Recipe.WeaponDamageType == EWeaponDamageType::BothHands)
+		{
+			SourceSnapshot.WeaponDamage += Random.GetRange(EMOBACombatRoll::OffHandDamage, OffHandMinDamage, OffHandMaxDamage);
+		}
+		SourceSnapshot.CriticalMultiplier = Random.GetFraction(EMOBACombatRoll::Critical) < CriticalChance ? CriticalDamage : 1.0f;
+	}
+
+	// Evaluate a recipe against every target of a batch in one pass. OutHealthDeltas is indexed like the batch.
+	static void CalculateHealthDeltas(const FMOBADamageRecipe& Recipe, const FMOBADamageSourceSnapshot& SourceSnapshot, const FMOBADamageTargetBatch& Targets, TArray<float>& OutHealthDeltas);
 };
@@ -2,28 +2,40 @@
 
 
 #include "CalculateHealing.h"
+#include "CalculateDamage.h"
 #include "MOBAGameplayAbility.h"
 #include "MOBAAttributeSet.h"
 
 struct HealingStatics 
 {
+	// Target's Relevant Stats
+	DECLARE_ATTRIBUTE_CAPTUREDEF(Health);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(HealingModifier);
 	DECLARE_ATTRIBUTE_CAPTUREDEF(HealthRegen);
+	// Healer's Relevant Stats
+	DECLARE_ATTRIBUTE_CAPTUREDEF(AttackPower);
+	DECLARE_ATTRIBUTE_CAPTUREDEF(SpellPower);
 
 	HealingStatics() 
 	{
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UMOBAAttributeSet, Health, Target, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UMOBAAttributeSet, HealingModifier, Target, false);
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UMOBAAttributeSet, HealthRegen, Target, false);
+
+		// Snapshot the healer's power when the spec is created, same as damage
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UMOBAAttributeSet, AttackPower, Source, true);
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UMOBAAttributeSet, SpellPower, Source, true);
 	}
 };
 
-HealingStatics& Source()
+// Named apart from the damage statics accessors so both files can share a unity build
+static HealingStatics& HealingSource()
 {
 	static HealingStatics It;
 	return It;
 }
 
-HealingStatics& Target()
+static HealingStatics& HealingTarget()
 {
 	static HealingStatics It;
 	return It;
@@ -33,8 +45,11 @@ UCalculateHealing::UCalculateHealing(const FObjectInitializer& ObjectInitializer
 	: Super(ObjectInitializer)
 {
 	// Target
-	RelevantAttributesToCapture.Add(Target().HealingModifierDef);
-	RelevantAttributesToCapture.Add(Target().HealthRegenDef);
+	RelevantAttributesToCapture.Add(HealingTarget().HealingModifierDef);
+	RelevantAttributesToCapture.Add(HealingTarget().HealthRegenDef);
+	// Source
+	RelevantAttributesToCapture.Add(HealingSource().AttackPowerDef);
+	RelevantAttributesToCapture.Add(HealingSource().SpellPowerDef);
 }
 
 void UCalculateHealing::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const 
@@ -44,14 +59,45 @@ void UCalculateHealing::Execute_Implementation(const FGameplayEffectCustomExecut
 	FGameplayEffectContextHandle Handle = Spec.GetContext();
 	const UGameplayAbility* SourceAbility = Handle.GetAbility();
 	const UMOBAGameplayAbility* MOBASourceAbility = Cast<UMOBAGameplayAbility>(SourceAbility);
-	UClass* AbilityData;
-	UMOBAAbilityData* MOBAAbilityData;
-	if (MOBASourceAbility)
+	if (!MOBASourceAbility) return;
+	const FMOBADamageRecipe Recipe = UMOBAAbilityData::GetDamageRecipe(MOBASourceAbility->AbilityData);
+	if (Recipe.Kind != EMOBARecipeKind::Heal && Recipe.Kind != EMOBARecipeKind::HealthRegen) return;
+
+	FAggregatorEvaluateParameters EvaluationParameters;
+	EvaluationParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	EvaluationParameters.TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+	// Target relevant parameters
+	float HealingModifier = 0.f;
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(HealingTarget().HealingModifierDef, EvaluationParameters, HealingModifier);
+	float HealthRegen = 0.f;
+	if (Recipe.Kind == EMOBARecipeKind::HealthRegen)
+	{
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(HealingTarget().HealthRegenDef, EvaluationParameters, HealthRegen);
+	}
+
+	// Source relevant parameters, regeneration does not scale with the healer
+	FMOBADamageSourceSnapshot SourceSnapshot;
+	if (Recipe.Kind == EMOBARecipeKind::Heal)
 	{
-		AbilityData = MOBASourceAbility->AbilityData;
-		UObject* AbilityDataObj = AbilityData->ClassDefaultObject;
-		MOBAAbilityData = Cast<UMOBAAbilityData>(AbilityDataObj);
-		if (!MOBAAbilityData) return;
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(HealingSource().AttackPowerDef, EvaluationParameters, SourceSnapshot.AttackPower);
+		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(HealingSource().SpellPowerDef, EvaluationParameters, SourceSnapshot.SpellPower);
 	}
-	else return;
-}
\ No newline at end of file
+
+	const float HealAmount = CalculateHealAmount(Recipe, UCalculateDamage::CalculateRecipeValue(Recipe, SourceSnapshot), HealingModifier, HealthRegen);
+	if (HealAmount != 0.f)
+	{
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(HealingTarget().HealthProperty, EGameplayModOp::Additive, HealAmount));
+	}
+}
+
+void UCalculateHealing::CalculateHealAmounts(const FMOBADamageRecipe& Recipe, float RecipeValue, const TArray<float>& HealingModifier, const TArray<float>& HealthRegen, TArray<float>& OutHealAmounts)
+{
+	const int32 NumTargets = HealingModifier.Num();
+	check(HealthRegen.Num() == NumTargets);
+	OutHealAmounts.SetNumUninitialized(NumTargets);
+	for (int32 Index = 0; Index < NumTargets; Index++)
+	{
+		OutHealAmounts[Index] = CalculateHealAmount(Recipe, RecipeValue, HealingModifier[Index], HealthRegen[Index]);
+	}
+}
@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameplayEffectExecutionCalculation.h"
+#include "MOBAGameplayAbility.h"
 #include "CalculateHealing.generated.h"
 
 /**
- * 
+ * Heal execution. Captures only the target's HealingModifier and HealthRegen and the source's power stats,
+ * and reads the same per ability data recipe cache as UCalculateDamage.
  */
 UCLASS()
 class MOBA_API UCalculateHealing : public UGameplayEffectExecutionCalculation
@@ -15,4 +17,19 @@ class MOBA_API UCalculateHealing : public UGameplayEffectExecutionCalculation
 	GENERATED_UCLASS_BODY()
 
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+
+public:
+	// Health restored to one target by a Heal or HealthRegen recipe. RecipeValue is base value plus source ratios.
+	static FORCEINLINE float CalculateHealAmount(const FMOBADamageRecipe& Recipe, float RecipeValue, float HealingModifier, float HealthRegen)
+	{
+		switch (Recipe.Kind)
+		{
+		case EMOBARecipeKind::Heal: return FMath::Max(RecipeValue * HealingModifier, 0.0f);
+		case EMOBARecipeKind::HealthRegen: return FMath::Max((HealthRegen / 5) * HealingModifier, 0.0f);
+		default: return 0.0f;
+		}
+	}
+
+	// Evaluate a heal recipe for a batch of targets in one pass. Target arrays and OutHealAmounts share indices.
+	static void CalculateHealAmounts(const FMOBADamageRecipe& Recipe, float RecipeValue, const TArray<float>& HealingModifier, const TArray<float>& HealthRegen, TArray<float>& OutHealAmounts);
 };
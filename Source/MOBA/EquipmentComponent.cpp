@@ -6,17 +6,20 @@
 #include "MOBAAttributeSet.h"
 #include "AbilitySystemComponent.h"
 
-void UItem::SetCurrentStacks(int32 NewStackCount)
+bool FItemInstance::IsEmpty() const
 {
-	// Destroy item if new stack count is 0
-	if (NewStackCount == 0)
-	{
-		MyOwner->EquipmentComponent->RemoveItemFromInventory(this, true);
-		return;
-	}
+	return !ItemClass || Stacks <= 0;
+}
+
+const UItem* FItemInstance::GetDefinition() const
+{
+	return ItemClass ? GetDefault<UItem>(ItemClass) : NULL;
+}
 
-	// Stack count was not zero, use new value
-	CurrentStacks = FMath::Clamp(NewStackCount, 1, MaxStacks); // Enforce valid stack count
+void UItem::SetCurrentStacks(int32 NewStackCount)
+{
+	// Item objects are copies of an inventory slot, the slot itself is changed through the equipment component
+	CurrentStacks = FMath::Clamp(NewStackCount, 0, MaxStacks); // Enforce valid stack count
 	return;
 }
 
@@ -46,7 +49,8 @@ UEquipmentComponent::UEquipmentComponent()
 	
 	// Set default MaxInventorySize and Initialize Inventory
 	MaxInventorySize = 6;
-	Inventory.Init(NULL, MaxInventorySize);
+	Inventory.Init(FItemInstance(), MaxInventorySize);
+	RebuildInventoryIndex();
 }
 
 
@@ -55,8 +59,8 @@ void UEquipmentComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
-	
+	// Inventory and its size may have been set in the editor
+	RebuildInventoryIndex();
 }
 
 
@@ -68,26 +72,23 @@ void UEquipmentComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 	// ...
 }
 
-// Function to add an item to inventory. ExistingItem is an optional parameter. WARNING: ReturnedItem may be NULL.
-void UEquipmentComponent::AddItemToInventory(const TSubclassOf<class UItem> ItemClass, TArray<UItem*> &ReturnedItems, EInventoryMessage &Message, UItem* const ExistingItem, const int32 Quantity)
+// Function to add an item to inventory. ReturnedIndices holds every inventory slot that received stacks.
+void UEquipmentComponent::AddItemToInventory(const TSubclassOf<class UItem> ItemClass, TArray<int32> &ReturnedIndices, EInventoryMessage &Message, const int32 Quantity)
 {
 	// Initialize variables
-	bool Instanced = false;
 	bool AnotherExists = false;
 	bool Unique = false;
 	bool CanStack = false;
 	int32 AvailableInventorySlots = 0;
-	UItem* Item = NULL;
 	int32 QuantityRemaining = Quantity;
 	int32 InventorySlotsRequired = 0;
 	int32 SlotsUsed = 0;
 	TArray<int32> EmptyInventorySlotIndices; // Holds position of empty slots in inventory
 	// Arrays for delegate to broadcast
-	TArray<UItem*> AffectedItems;
+	TArray<FItemInstance> AffectedItems;
 	TArray<int32> AffectedIndices;
-	// Use ItemClass to get a default object
-	UObject* ItemBPObj = ItemClass->ClassDefaultObject;
-	Item = Cast<UItem>(ItemBPObj);
+	// The class default object is the shared definition of the item
+	const UItem* Item = ItemClass ? GetDefault<UItem>(ItemClass) : NULL;
 	
 	// Verify item class is valid, abort if not
 	if (!Item) 
@@ -106,41 +107,32 @@ void UEquipmentComponent::AddItemToInventory(const TSubclassOf<class UItem> Item
 		return;
 	}
 
-	InventorySlotsRequired = (Quantity + Item->GetMaxStacks() - 1) / Item->GetMaxStacks(); // How many inventory slots are required
+	const int32 MaxStacks = FMath::Max(Item->GetMaxStacks(), 1);
+	InventorySlotsRequired = (Quantity + MaxStacks - 1) / MaxStacks; // How many inventory slots are required
 	
-	// Find number of available inventory slots
-	for (int i = 0; i < MaxInventorySize; i++) 
-	{
-		// Create pointer to current inventory index
-		UItem* CurrentItem = Inventory[i];
-		// Check if a valid pointer is there
-		if (!CurrentItem->IsValidLowLevel()) 
-		{
-			// No item is here, increment available slots and note the index of that empty slot
-			AvailableInventorySlots++;
-			EmptyInventorySlotIndices.Add(i);
-		}
-	}
+	// Find number of available inventory slots and note the index of each empty slot
+	AvailableInventorySlots = GetEmptyInventorySlots(EmptyInventorySlotIndices);
 
 	
 	// Should we try to add stacks to an existing inventory slot before filling a new inventory slot?
-	CanStack = (Item->GetMaxStacks() > 1) ? true : false;
+	CanStack = (MaxStacks > 1) ? true : false;
 
 	// If we can stack, check and see if any of the existing items have room for more stacks
-	TArray<UItem*> FilterArray = ItemInstancesAlreadyPresentInInventory(ItemClass);
+	TArray<int32> SameClassSlots;
+	GetInventorySlotsOfClass(ItemClass, SameClassSlots);
 	if (CanStack) 
 	{
 		// Get all items in inventory of the same class and check and see if any of them have room for more stacks
 		SlotsUsed = InventorySlotsRequired;
-		int32 QuantityStacked = 0;
 		
-		for (auto& AnotherItem : FilterArray)
+		for (int32 SameClassSlot : SameClassSlots)
 		{
+			const FItemInstance& AnotherItem = Inventory[SameClassSlot];
 			// Test if the operation can be performed prior to actually changing anything
-			if (AnotherItem->GetCurrentStacks() < AnotherItem->GetMaxStacks())
+			if (AnotherItem.Stacks < MaxStacks)
 			{
 				// Item with available stacks found, add stacks and decrement number of stacks to add
-				int32 AvailableStacks = AnotherItem->GetMaxStacks() - AnotherItem->GetCurrentStacks();
+				int32 AvailableStacks = MaxStacks - AnotherItem.Stacks;
 				int32 StacksUsed = (QuantityRemaining >= AvailableStacks) ? AvailableStacks : QuantityRemaining;
 				QuantityRemaining -= StacksUsed;
 				SlotsUsed--;
@@ -169,62 +161,41 @@ void UEquipmentComponent::AddItemToInventory(const TSubclassOf<class UItem> Item
 	// Use stacks of existing item instances first
 	if (CanStack) 
 	{
-		for (auto& AnotherItem : FilterArray)
+		for (int32 SameClassSlot : SameClassSlots)
 		{
-			UItem* CurrentItem = CastChecked<UItem>(AnotherItem);
+			FItemInstance& CurrentItem = Inventory[SameClassSlot];
 			// Find other item instances with available stacks
-			if (CurrentItem->GetCurrentStacks() < CurrentItem->GetMaxStacks())
+			if (CurrentItem.Stacks < MaxStacks)
 			{
 				// Item with available stacks found, add stacks and decrement number of stacks to add
-				int32 AvailableStacks = CurrentItem->GetMaxStacks() - CurrentItem->GetCurrentStacks();
+				int32 AvailableStacks = MaxStacks - CurrentItem.Stacks;
 				// Use whichever value is lower, quantity remaining or available stacks
 				int32 StacksUsed = (QuantityRemaining >= AvailableStacks) ? AvailableStacks : QuantityRemaining;
 				QuantityRemaining -= StacksUsed;
 				
-				// Update item to reflect stack change
-				CurrentItem->SetCurrentStacks(CurrentItem->GetCurrentStacks() + StacksUsed);
+				// Update the slot in place, its class doesn't change so the index stays valid
+				CurrentItem.Stacks += StacksUsed;
+				ReturnedIndices.Add(SameClassSlot);
+				AffectedItems.Add(CurrentItem);
+				AffectedIndices.Add(SameClassSlot);
 				// End if there are no more stacks to add
 				if (QuantityRemaining <= 0) break;
-				// Add this item to the list of affected items if we haven't already
-				ReturnedItems.AddUnique(CurrentItem);
-				AffectedItems.Add(CurrentItem);
-				AffectedIndices.Add(Inventory.Find(CurrentItem));
 			}
 		}
 	}
 	
-	// Create new inventory slots for each remaining slot required
-	for (int32 i = 0; i < SlotsUsed; i++) 
+	// Fill new inventory slots for each remaining slot required
+	for (int32 i = 0; i < SlotsUsed && QuantityRemaining > 0; i++) 
 	{
-		if (i == 0) 
-		{
-			// Get Item Properties to determine what we can do
-			Instanced = Cast<UItem>(ExistingItem) ? true : false; // Does the item exist already or do we need to create a new instance
-			if (!Instanced)
-			{
-				Item = NewObject<UItem>(this, ItemClass);
-			}
-			else 
-			{
-				Item = ExistingItem;
-			}
-		}
-		else 
-		{
-			Item = NewObject<UItem>(this, ItemClass);
-		}
-		int32 AvailableStacks = Item->GetMaxStacks();
-		int32 StacksUsed = (QuantityRemaining >= AvailableStacks) ? AvailableStacks : QuantityRemaining;
-		QuantityRemaining -= StacksUsed;
-		Item->SetCurrentStacks(StacksUsed);
-		Item->SetOwner(CastChecked<AMOBACharacter>(this->GetOwner()));
+		FItemInstance NewItem;
+		NewItem.ItemClass = ItemClass;
+		NewItem.Stacks = (QuantityRemaining >= MaxStacks) ? MaxStacks : QuantityRemaining;
+		QuantityRemaining -= NewItem.Stacks;
 		// Add item to inventory and update delegate arrays
-		Inventory[EmptyInventorySlotIndices[i]] = Item;
-		AffectedItems.Add(Item);
+		SetInventorySlot(EmptyInventorySlotIndices[i], NewItem);
+		AffectedItems.Add(NewItem);
 		AffectedIndices.Add(EmptyInventorySlotIndices[i]);
-		// Add this item as a returned item reference
-		ReturnedItems.Add(Item);
-		if (QuantityRemaining <= 0) break;
+		ReturnedIndices.Add(EmptyInventorySlotIndices[i]);
 	}
 	Message = EInventoryMessage::Success;
 	
@@ -233,32 +204,30 @@ void UEquipmentComponent::AddItemToInventory(const TSubclassOf<class UItem> Item
 	return;	
 }
 
-// Function to remove an item from inventory. 
-EInventoryMessage UEquipmentComponent::RemoveItemFromInventory(UItem* ItemToRemove, bool Delete, int32 NumberOfStacksToRemove)
+// Function to remove stacks of an item from inventory. The slot is emptied once its last stack is removed.
+EInventoryMessage UEquipmentComponent::RemoveItemFromInventory(int32 InventoryIndex, int32 NumberOfStacksToRemove)
 {
-	// Verify that the item is actually in the inventory
-	if (Inventory.Contains(ItemToRemove))
+	// A negative count would add stacks past the item's maximum
+	if (NumberOfStacksToRemove <= 0) return EInventoryMessage::InvalidQuantity;
+	// Verify that there is actually an item in the slot
+	if (Inventory.IsValidIndex(InventoryIndex) && !Inventory[InventoryIndex].IsEmpty())
 	{
 		// Create return value for delegate and add the item as an affected inventory slot
-		TArray<UItem*> AffectedItems;
+		TArray<FItemInstance> AffectedItems;
 		TArray<int32> AffectedIndices;
 		
-		AffectedIndices.Add(Inventory.Find(ItemToRemove));
+		AffectedIndices.Add(InventoryIndex);
 
 		// Check if we are just removing some stacks or actually removing the entire item
-		if (NumberOfStacksToRemove >= ItemToRemove->GetCurrentStacks()) 
+		if (NumberOfStacksToRemove >= Inventory[InventoryIndex].Stacks) 
 		{	
-			Inventory[Inventory.Find(ItemToRemove)] = NULL;
-			if (ItemToRemove->GetItemType() == EItemType::Consumable || Delete) 
-			{
-				ItemToRemove->BeginDestroy();
-			}
+			SetInventorySlot(InventoryIndex, FItemInstance());
 		}
 		else 
 		{
-			// Only Removing Stacks, decrement stacks and add item to delegate. item is not added if removed/deleted
-			ItemToRemove->SetCurrentStacks(ItemToRemove->GetCurrentStacks() - NumberOfStacksToRemove);
-			AffectedItems.Add(ItemToRemove);
+			// Only Removing Stacks, decrement stacks and add item to delegate. item is not added if removed
+			Inventory[InventoryIndex].Stacks -= NumberOfStacksToRemove;
+			AffectedItems.Add(Inventory[InventoryIndex]);
 		}
 				
 		// Broadcast Delegate and return
@@ -274,17 +243,17 @@ UFUNCTION(BlueprintCallable)
 EInventoryMessage UEquipmentComponent::SwapItemsInInventory(int32 Index1, int32 Index2) 
 {
 	// Verify that both indices are valid and that at least one of the items exists. We can move to an empty slot if one of the items doesn't exist
-	if ((Inventory.IsValidIndex(Index1) && Inventory.IsValidIndex(Index2)) && (Inventory[Index1]->IsValidLowLevel() || Inventory[Index2]->IsValidLowLevel()))
+	if ((Inventory.IsValidIndex(Index1) && Inventory.IsValidIndex(Index2)) && (!Inventory[Index1].IsEmpty() || !Inventory[Index2].IsEmpty()))
 	{
 		// Create arrays for the delegate to broadcast
-		TArray<UItem*> AffectedItems;
+		TArray<FItemInstance> AffectedItems;
 		TArray<int32> AffectedIndices;
-		// Create item pointers
-		UItem* FirstItem = Inventory[Index1];
-		UItem* SecondItem = Inventory[Index2];
+		// Copy both slots
+		FItemInstance FirstItem = Inventory[Index1];
+		FItemInstance SecondItem = Inventory[Index2];
 		// Swap items
-		Inventory[Index1] = SecondItem;
-		Inventory[Index2] = FirstItem;
+		SetInventorySlot(Index1, SecondItem);
+		SetInventorySlot(Index2, FirstItem);
 		// Fill arrays for delegate to broadcast
 		AffectedItems.Add(FirstItem);
 		AffectedItems.Add(SecondItem);
@@ -297,67 +266,85 @@ EInventoryMessage UEquipmentComponent::SwapItemsInInventory(int32 Index1, int32
 	else return EInventoryMessage::DoesNotExist;
 }
 
-int32 UEquipmentComponent::GetEmptyInventorySlots(TArray<int32>& OptionalIndexArray) 
+UItem* UEquipmentComponent::GetInventoryItemObject(int32 InventoryIndex)
 {
-	int32 EmptySlotCount = 0;
-	for (auto & Item : Inventory) 
+	if (!Inventory.IsValidIndex(InventoryIndex) || Inventory[InventoryIndex].IsEmpty()) return NULL;
+	const FItemInstance& Slot = Inventory[InventoryIndex];
+	UItem* Item = NewObject<UItem>(this, Slot.ItemClass);
+	Item->SetCurrentStacks(Slot.Stacks);
+	Item->SetOwner(Cast<AMOBACharacter>(GetOwner()));
+	if (UEquipment* Equipment = Cast<UEquipment>(Item))
 	{
-		if (!Item->IsValidLowLevel()) 
+		TArray<UEquipment*> ModuleObjects;
+		for (const TSubclassOf<UEquipment>& ModuleClass : Slot.Modules)
 		{
-			EmptySlotCount++;
-			if (OptionalIndexArray.GetData() != nullptr) 
-			{
-				OptionalIndexArray.Add(Inventory.Find(Item));
-			}
+			if (ModuleClass) ModuleObjects.Add(NewObject<UEquipment>(Equipment, ModuleClass));
 		}
+		Equipment->SetEquippedModules(ModuleObjects);
 	}
-	return EmptySlotCount;
+	return Item;
 }
 
-// This function determines if we should add new stacks to an existing item, or create a new one.
-bool UEquipmentComponent::ClassAlreadyPresentInInventory(TSubclassOf<UItem> ItemClass)
+int32 UEquipmentComponent::GetEmptyInventorySlots(TArray<int32>& OptionalIndexArray) 
 {
-	for (auto & Item : Inventory) 
+	// Walk the set bits of the empty slot mask, lowest slot first
+	for (uint64 RemainingSlots = EmptyInventorySlotMask; RemainingSlots != 0; RemainingSlots &= RemainingSlots - 1)
 	{
-		if (Item->IsValidLowLevel()) 
-		{
-			if (Item->GetClass() == ItemClass) 
-			{
-				return true;
-			}
-		}
+		OptionalIndexArray.Add(static_cast<int32>(FMath::CountTrailingZeros64(RemainingSlots)));
 	}
-	return false;
+	return GetNumEmptyInventorySlots();
+}
+
+// This function determines if we should add new stacks to an existing item, or create a new one.
+bool UEquipmentComponent::ClassAlreadyPresentInInventory(TSubclassOf<UItem> ItemClass)
+{
+	return InventoryClassSlots.Contains(ItemClass);
 }
 
-// Find all items in inventory of the given class
-TArray<UItem*> UEquipmentComponent::ItemInstancesAlreadyPresentInInventory(TSubclassOf<UItem> ItemClass) 
+void UEquipmentComponent::SetInventorySlot(int32 Index, const FItemInstance& Item)
 {
-	TArray<UItem*> Filter;
-	for (auto & Item : Inventory) 
+	if (!Inventory[Index].IsEmpty())
 	{
-		if (Item->IsValidLowLevel()) 
-		{
-			if (Item->GetClass() == ItemClass)
-			{
-				Filter.Add(Item);
-			}
-		}
+		InventoryClassSlots.RemoveSingle(Inventory[Index].ItemClass, Index);
+	}
+	if (!Item.IsEmpty())
+	{
+		Inventory[Index] = Item;
+		InventoryClassSlots.Add(Item.ItemClass, Index);
+		EmptyInventorySlotMask &= ~(1ULL << Index);
+	}
+	else
+	{
+		Inventory[Index] = FItemInstance();
+		EmptyInventorySlotMask |= 1ULL << Index;
 	}
-	
-	return Filter;
 }
 
-// Are we adding stacks to a specific item?
-bool UEquipmentComponent::ItemInstanceAlreadyPresentInInventory(UItem* Item) 
+void UEquipmentComponent::GetInventorySlotsOfClass(UClass* ItemClass, TArray<int32>& OutSlots) const
 {
-	
-	TArray<UItem*> PresentItemsOfSameClass = ItemInstancesAlreadyPresentInInventory(Item->GetClass());
-	for (auto& ItemInstance : PresentItemsOfSameClass) 
+	InventoryClassSlots.MultiFind(ItemClass, OutSlots);
+	OutSlots.Sort();
+}
+
+void UEquipmentComponent::RebuildInventoryIndex()
+{
+	if (MaxInventorySize > MaxIndexedInventorySize)
 	{
-		if (ItemInstance == Item) return true;
+		UE_LOG(LogTemp, Warning, TEXT("%s: MaxInventorySize %d clamped to %d"), *GetNameSafe(this), MaxInventorySize, MaxIndexedInventorySize);
+		MaxInventorySize = MaxIndexedInventorySize;
+	}
+	Inventory.SetNum(MaxInventorySize);
+	EmptyInventorySlotMask = 0;
+	InventoryClassSlots.Reset();
+	for (int32 Index = 0; Index < Inventory.Num(); Index++)
+	{
+		const FItemInstance& Item = Inventory[Index];
+		if (!Item.IsEmpty())
+		{
+			InventoryClassSlots.Add(Item.ItemClass, Index);
+		}
+		else EmptyInventorySlotMask |= 1ULL << Index;
 	}
-	return false;
 }
 
 // Function to equip a new item on the character.
@@ -412,10 +399,6 @@ EInventoryMessage UEquipmentComponent::Equip(ESlotType SlotToEquip, UEquipment*
 					if ((FoundEquipment->GetMaxSlots() > ExistingModules.Num()) && (ExistingModules.Num()  >= 0))
 					{
 						ExistingModules.Add(ItemToEquip);
-						if (ItemInstanceAlreadyPresentInInventory(ItemToEquip)) 
-						{
-							RemoveItemFromInventory(ItemToEquip);
-						}
 					}
 					else return EInventoryMessage::ModuleSlotsFull;
 
@@ -437,26 +420,16 @@ EInventoryMessage UEquipmentComponent::Equip(ESlotType SlotToEquip, UEquipment*
 			// Additional steps required for equipping a two hand weapon
 			if (ItemToEquip->GetItemType() == EItemType::TwoHand)
 			{
-				int32 SlotsRequired = 0;
-				bool TwoHandRemovedFromInventory = false;
 				// Make sure that we actually can put enough items back in inventory to equip a two hand weapon
-				if (ItemInstanceAlreadyPresentInInventory(ItemToEquip))
-				{
-					RemoveItemFromInventory(ItemToEquip);
-					TwoHandRemovedFromInventory = true;
-					SlotsRequired--;
-				}
-				// Check if there are enough inventory slots to do the transaction
+				// A two hand weapon equipped from inventory has already freed its own slot
+				int32 SlotsRequired = 0;
 				TArray<int32> EmptyInventorySlotsArray;
-				TArray<UItem*> ReturnedItems;
-				EInventoryMessage AddItemsMessage;
 				
 				if (EquipmentSlots.Contains(ESlotType::MainHand)) SlotsRequired++;
 				if (EquipmentSlots.Contains(ESlotType::OffHand)) SlotsRequired++;
 				if (GetEmptyInventorySlots(EmptyInventorySlotsArray) < SlotsRequired)
 				{
-					// Not enough slots, put the two hand weapon back in inventory and abort
-					if (TwoHandRemovedFromInventory) AddItemToInventory(ItemToEquip->GetClass(), ReturnedItems, AddItemsMessage, ItemToEquip, 1);
+					// Not enough slots, abort
 					return EInventoryMessage::InventoryFull;
 				}
 
@@ -509,7 +482,6 @@ EInventoryMessage UEquipmentComponent::Equip(ESlotType SlotToEquip, UEquipment*
 					return EInventoryMessage::DoesNotExist;
 				}
 			}
-			RemoveItemFromInventory(ItemToEquip);
 			return EInventoryMessage::Success;
 			
 		}
@@ -518,12 +490,61 @@ EInventoryMessage UEquipmentComponent::Equip(ESlotType SlotToEquip, UEquipment*
 	return EInventoryMessage::DoesNotExist;
 }
 
+EInventoryMessage UEquipmentComponent::EquipFromInventory(ESlotType SlotToEquip, int32 InventoryIndex)
+{
+	// Verify the slot holds equipment
+	if (!Inventory.IsValidIndex(InventoryIndex) || Inventory[InventoryIndex].IsEmpty()) return EInventoryMessage::DoesNotExist;
+	const FItemInstance Slot = Inventory[InventoryIndex];
+	if (!Slot.ItemClass->IsChildOf(UEquipment::StaticClass())) return EInventoryMessage::InvalidEquipment;
+
+	// Equipped items are the only ones that live as objects, create it now
+	UEquipment* ItemToEquip = CastChecked<UEquipment>(GetInventoryItemObject(InventoryIndex));
+	ItemToEquip->SetCurrentStacks(1);
+
+	// Take it out of the inventory first so its slot counts as free while equipping
+	FItemInstance Remaining = Slot;
+	Remaining.Stacks--;
+	SetInventorySlot(InventoryIndex, Remaining);
+
+	EInventoryMessage Message = Equip(SlotToEquip, ItemToEquip);
+	if (Message != EInventoryMessage::Success)
+	{
+		// Put it back where it was unless equipping already refilled the slot
+		if (Inventory[InventoryIndex].Stacks == Remaining.Stacks && (Remaining.Stacks == 0 || Inventory[InventoryIndex].ItemClass == Slot.ItemClass))
+		{
+			SetInventorySlot(InventoryIndex, Slot);
+		}
+		else ReturnEquipmentToInventory(ItemToEquip);
+		return Message;
+	}
+
+	TArray<FItemInstance> AffectedItems;
+	TArray<int32> AffectedIndices;
+	if (!Inventory[InventoryIndex].IsEmpty()) AffectedItems.Add(Inventory[InventoryIndex]);
+	AffectedIndices.Add(InventoryIndex);
+	OnInventoryChange.Broadcast(AffectedItems, AffectedIndices);
+	return EInventoryMessage::Success;
+}
+
+EInventoryMessage UEquipmentComponent::ReturnEquipmentToInventory(UEquipment* Equipment)
+{
+	TArray<int32> ReturnedIndices;
+	EInventoryMessage Message;
+	AddItemToInventory(Equipment->GetClass(), ReturnedIndices, Message, 1);
+	if (Message == EInventoryMessage::Success && ReturnedIndices.Num() > 0)
+	{
+		// Keep the fitted modules with the item, the equipment object itself is dropped
+		FItemInstance& Slot = Inventory[ReturnedIndices.Last()];
+		for (UEquipment* Module : Equipment->GetEquippedModules())
+		{
+			if (Module) Slot.Modules.Add(Module->GetClass());
+		}
+	}
+	return Message;
+}
+
 EInventoryMessage UEquipmentComponent::UnEquip(ESlotType SlotToUnequip)
 {
-	// Return storage containers for inventory operations
-	TArray<UItem*> ReturnedItems;
-	EInventoryMessage ReturnedMessage;
-	
 	// Verify there is at least one inventory slot available
 	TArray<int32> EmptyInventorySlots;
 	if (GetEmptyInventorySlots(EmptyInventorySlots) < 1) 
@@ -542,7 +563,7 @@ EInventoryMessage UEquipmentComponent::UnEquip(ESlotType SlotToUnequip)
 	if (!RemoveEquipmentFromCharacter(ItemToUnequip)) return EInventoryMessage::DoesNotExist;
 	
 	// Return the item to inventory	
-	AddItemToInventory(ItemToUnequip->StaticClass(), ReturnedItems, ReturnedMessage, ItemToUnequip);
+	ReturnEquipmentToInventory(ItemToUnequip);
 	return EInventoryMessage::Success;
 }
 
@@ -594,11 +615,6 @@ EInventoryMessage UEquipmentComponent::SwapEquipment(UEquipment* Equipment1, UEq
 					return EInventoryMessage::InvalidEquipment;
 				}
 				
-				// Remove second item from inventory if it is in there
-				if (ItemInstanceAlreadyPresentInInventory(CastChecked<UItem>(ItemToAdd)))
-				{
-					RemoveItemFromInventory(ItemToAdd);
-				}
 				// Equip second item and grant gameplay effects
 				if (!AddEquipmentToCharacter(ItemToAdd)) 
 				{
@@ -607,9 +623,7 @@ EInventoryMessage UEquipmentComponent::SwapEquipment(UEquipment* Equipment1, UEq
 					return EInventoryMessage::InvalidEquipment;
 				}
 				// Add first item to inventory
-				TArray<UItem*> ReturnedItems;
-				EInventoryMessage Message;
-				AddItemToInventory(CastChecked<UItem>(ItemToRemove)->GetClass(), ReturnedItems, Message, ItemToRemove, 1);
+				ReturnEquipmentToInventory(ItemToRemove);
 				return EInventoryMessage::Success;
 			}
 			else 
@@ -11,10 +11,9 @@
 #include "Projectile.h"
 #include "EquipmentComponent.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryChange, TArray<UItem*>, AffectedItems, TArray<int32>, AffectedInventoryIndices);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEquipmentChange, uint8, AffectedSlot, UEquipment*, EquipmentObjRef); // Affected slot will be converted to ESlotType later
-
 class AMOBACharacter;
+class UItem;
+class UEquipment;
 
 UENUM(BlueprintType)
 enum class EItemType : uint8
@@ -55,8 +54,33 @@ enum class EInventoryMessage : uint8
 	ModuleSlotsFull UMETA(DisplayName = "ModuleSlotsFull"),
 	WrongSlot UMETA(DisplayName = "WrongEquipmentSlot"),
 	InvalidEquipment UMETA(DisplayName = "InvalidEquipment"),
+	InvalidQuantity UMETA(DisplayName = "InvalidQuantity"),
+};
+
+// One inventory slot. The item's class default object is its shared, read only definition.
+USTRUCT(BlueprintType)
+struct FItemInstance
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+		TSubclassOf<UItem> ItemClass;
+
+	// How many items occupy this slot
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+		int32 Stacks = 0;
+
+	// Modules fitted to this equipment while it sits in the inventory
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+		TArray<TSubclassOf<UEquipment>> Modules;
+
+	bool IsEmpty() const;
+	const UItem* GetDefinition() const;
 };
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryChange, TArray<FItemInstance>, AffectedItems, TArray<int32>, AffectedInventoryIndices);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEquipmentChange, uint8, AffectedSlot, UEquipment*, EquipmentObjRef); // Affected slot will be converted to ESlotType later
+
 // Base characteristics that all items have
 UCLASS(Blueprintable, BlueprintType)
 class UItem : public UObject
@@ -132,6 +156,7 @@ public:
 	FORCEINLINE bool GetModuleUniqueEquipped() { return bModuleUniqueEquipped; }
 	FORCEINLINE int32 GetMaxSlots() { return MaxModuleSlots; }
 	FORCEINLINE TArray<UEquipment*> GetEquippedModules() { return EquippedModules; }
+	FORCEINLINE void SetEquippedModules(const TArray<UEquipment*>& NewModules) { EquippedModules = NewModules; }
 	ESlotType GetEquipmentSlotType();
 };
 
@@ -184,11 +209,13 @@ public:
 	// Sets default values for this component's properties
 	UEquipmentComponent();
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
-	TArray<UItem*> Inventory; // Items the character currently owns
+	// Items the character currently owns. Read only to Blueprints, writes go through SetInventorySlot to keep the index current.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory")
+	TArray<FItemInstance> Inventory;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
-	TArray<UItem*> RemovedInventory; // Probably will move this to an independent shop later
+	// No longer written. Kept so Blueprints that read it still load.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (DeprecatedProperty, DeprecationMessage = "Removed items are no longer recorded, listen to OnInventoryChange instead."))
+	TArray<FItemInstance> RemovedInventory;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
 	int32 MaxInventorySize;
@@ -197,10 +224,10 @@ public:
 	TMap<ESlotType, UEquipment*> EquipmentSlots;
 
 	UFUNCTION(BlueprintCallable)
-	void AddItemToInventory(const TSubclassOf<class UItem> ItemClass, TArray<UItem*> &ReturnedItems, EInventoryMessage &Message, UItem* const ExistingItem = NULL, const int32 Quantity = 1);
+	void AddItemToInventory(const TSubclassOf<class UItem> ItemClass, TArray<int32> &ReturnedIndices, EInventoryMessage &Message, const int32 Quantity = 1);
 
 	UFUNCTION(BlueprintCallable)
-	EInventoryMessage RemoveItemFromInventory(UItem* ItemToRemove, bool Delete = false, int32 NumberOfStacksToRemove = 1);
+	EInventoryMessage RemoveItemFromInventory(int32 InventoryIndex, int32 NumberOfStacksToRemove = 1);
 
 	UFUNCTION(BlueprintCallable)
 		EInventoryMessage SwapItemsInInventory(int32 Index1, int32 Index2);
@@ -208,23 +235,51 @@ public:
 	UFUNCTION(BlueprintCallable)
 		int32 GetEmptyInventorySlots(TArray<int32>& OptionalIndexArray);
 	
+	// Equip the equipment in an inventory slot. Its equipment object is created here.
 	UFUNCTION(BlueprintCallable)
-	EInventoryMessage Equip(ESlotType SlotToEquip, UEquipment* ItemToEquip);
+		EInventoryMessage EquipFromInventory(ESlotType SlotToEquip, int32 InventoryIndex);
+
+	// Object copy of an inventory slot for Blueprint inspection. Changing it doesn't change the inventory.
+	UFUNCTION(BlueprintCallable)
+		UItem* GetInventoryItemObject(int32 InventoryIndex);
 	
 	UFUNCTION(BlueprintCallable)
 	EInventoryMessage UnEquip(ESlotType SlotToUnequip);
 
+	// Rebuild the empty slot mask and class index from Inventory. Call after writing Inventory directly from C++.
 	UFUNCTION(BlueprintCallable)
-	EInventoryMessage SwapEquipment(UEquipment* Equipment1, UEquipment* Equipment2);
+		void RebuildInventoryIndex();
+
+	FORCEINLINE int32 GetNumEmptyInventorySlots() const { return FMath::CountBits(EmptyInventorySlotMask); }
+
+	// Inventories are indexed by a 64 bit mask
+	static constexpr int32 MaxIndexedInventorySize = 64;
 
 // Helper Inventory functions, not to be called directly
 private:
 	UFUNCTION()
 		bool ClassAlreadyPresentInInventory(TSubclassOf<UItem> ItemClass);
-	UFUNCTION()
-		TArray<UItem*> ItemInstancesAlreadyPresentInInventory(TSubclassOf<UItem> ItemClass);
-	UFUNCTION()
-		bool ItemInstanceAlreadyPresentInInventory(UItem* Item);
+
+	// Put an unequipped item back in the inventory with its modules
+	EInventoryMessage ReturnEquipmentToInventory(UEquipment* Equipment);
+
+	// Equip an equipment object taken from the inventory. Blueprints go through EquipFromInventory, which owns the object it passes in.
+	EInventoryMessage Equip(ESlotType SlotToEquip, UEquipment* ItemToEquip);
+
+	// Swap an equipment object with the one equipped in its slot. Only called by Equip.
+	EInventoryMessage SwapEquipment(UEquipment* Equipment1, UEquipment* Equipment2);
+
+	// Put Item in inventory slot Index, an empty instance to clear it. Every inventory write goes through here to keep the index current.
+	void SetInventorySlot(int32 Index, const FItemInstance& Item);
+
+	// Slots holding items of ItemClass, in slot order
+	void GetInventorySlotsOfClass(UClass* ItemClass, TArray<int32>& OutSlots) const;
+
+	// Bit i is set while inventory slot i is empty
+	uint64 EmptyInventorySlotMask = 0;
+
+	// Slots holding each item class
+	TMultiMap<UClass*, int32> InventoryClassSlots;
 
 	// Internal helper function to handle TMap operation and gameplay effects application. DOES NOT HANDLE INVENTORY OPERATION.
 	UFUNCTION()
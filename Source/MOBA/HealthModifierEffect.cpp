@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HealthModifierEffect.h"
+#include "MOBAAttributeSet.h"
+
+const FName UHealthModifierEffect::HealthDeltaName = FName("HealthDelta");
+
+UHealthModifierEffect::UHealthModifierEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FSetByCallerFloat HealthDelta;
+	HealthDelta.DataName = HealthDeltaName;
+
+	FGameplayModifierInfo HealthModifier;
+	HealthModifier.Attribute = FGameplayAttribute(FindFieldChecked<FProperty>(UMOBAAttributeSet::StaticClass(), GET_MEMBER_NAME_CHECKED(UMOBAAttributeSet, Health)));
+	HealthModifier.ModifierOp = EGameplayModOp::Additive;
+	HealthModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(HealthDelta);
+	Modifiers.Add(HealthModifier);
+}
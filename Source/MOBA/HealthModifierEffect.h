@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "HealthModifierEffect.generated.h"
+
+/**
+ * Instant effect that adds a set by caller amount to Health. Used to apply results computed outside of an execution calculation.
+ */
+UCLASS()
+class MOBA_API UHealthModifierEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UHealthModifierEffect();
+
+	// Set by caller name holding the Health delta (negative for damage, positive for healing)
+	static const FName HealthDeltaName;
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBAAttributeNotificationSubsystem.h"
+#include "MOBAAttributeSet.h"
+#include "Engine/World.h"
+
+void UMOBAAttributeNotificationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UMOBAAttributeNotificationSubsystem::OnWorldPostActorTick);
+}
+
+void UMOBAAttributeNotificationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingAttributeSets.Empty();
+	Super::Deinitialize();
+}
+
+void UMOBAAttributeNotificationSubsystem::QueueFlush(UMOBAAttributeSet* AttributeSet)
+{
+	PendingAttributeSets.Add(AttributeSet);
+}
+
+void UMOBAAttributeNotificationSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || PendingAttributeSets.Num() == 0) return;
+	// Listeners may change attributes again while we flush, those are picked up next frame
+	TArray<UMOBAAttributeSet*> AttributeSetsToFlush = MoveTemp(PendingAttributeSets);
+	PendingAttributeSets.Reset();
+	for (UMOBAAttributeSet* AttributeSet : AttributeSetsToFlush)
+	{
+		if (AttributeSet && !AttributeSet->IsPendingKill())
+		{
+			AttributeSet->FlushAttributeNotifications();
+		}
+	}
+}
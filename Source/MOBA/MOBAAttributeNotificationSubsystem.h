@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MOBAAttributeNotificationSubsystem.generated.h"
+
+class UMOBAAttributeSet;
+
+/**
+ * Collects attribute sets that changed during the frame and flushes their notifications once, after all actors have ticked.
+ */
+UCLASS()
+class MOBA_API UMOBAAttributeNotificationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Flush this attribute set at the end of the current frame
+	void QueueFlush(UMOBAAttributeSet* AttributeSet);
+
+protected:
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	UPROPERTY()
+		TArray<UMOBAAttributeSet*> PendingAttributeSets;
+
+	FDelegateHandle PostActorTickHandle;
+};
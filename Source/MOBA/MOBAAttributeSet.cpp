@@ -3,6 +3,8 @@
 
 #include "MOBAAttributeSet.h"
 #include "MOBACharacter.h"
+#include "MOBAAttributeNotificationSubsystem.h"
+#include "MOBACombatFormulas.h"
 
 UMOBAAttributeSet::UMOBAAttributeSet()
 	:Health(500.0f)
@@ -42,117 +44,234 @@ UMOBAAttributeSet::UMOBAAttributeSet()
 	if (ExperiencePerLevelObject.Succeeded())
 	{
 		ExperiencePerLevelData = ExperiencePerLevelObject.Object;
+		CacheExperiencePerLevel();
 	}
 }
 
-float UMOBAAttributeSet::CalculateDamageReduction(float ResistanceStat) 
+void UMOBAAttributeSet::CacheExperiencePerLevel()
 {
-	float damagereduction;
-	if (ResistanceStat >= 0)
+	ExperienceToNextLevel.Reset();
+	if (!ExperiencePerLevelData) return;
+	// Rows are named after the level they describe
+	for (const TPair<FName, uint8*>& Row : ExperiencePerLevelData->GetRowMap())
 	{
-		damagereduction = 1 - (100 / (100 + ResistanceStat));
+		const int32 RowLevel = FCString::Atoi(*Row.Key.ToString());
+		const FExperiencePerLevel* LevelData = reinterpret_cast<const FExperiencePerLevel*>(Row.Value);
+		if (RowLevel <= 0 || !LevelData) continue;
+		if (ExperienceToNextLevel.Num() <= RowLevel) ExperienceToNextLevel.SetNumZeroed(RowLevel + 1);
+		ExperienceToNextLevel[RowLevel] = LevelData->Experience;
 	}
-	else 
+}
+
+float UMOBAAttributeSet::CalculateDamageReduction(float ResistanceStat) 
+{
+	return FMOBACombatFormulas::DamageReduction(ResistanceStat);
+}
+
+namespace
+{
+	// Descriptor for every attribute, indexed by EMOBAAttribute. Replaces the per-attribute if chains in the effect callbacks.
+	const FMOBAAttributeDescriptor AttributeDescriptors[] =
+	{
+		{ EMOBAAttribute::Health, &UMOBAAttributeSet::Health, true, 0.0f, 0.0f, EMOBAAttribute::MaxHealth, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.HealthChange.Broadcast(Set.Health, Set.MaxHealth); } },
+		{ EMOBAAttribute::MaxHealth, &UMOBAAttributeSet::MaxHealth, true, 1.0f, 2147483647.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.HealthChange.Broadcast(Set.Health, Set.MaxHealth); } },
+		{ EMOBAAttribute::HealthRegen, &UMOBAAttributeSet::HealthRegen, true, 0.0f, 5000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.HealthRegenChange.Broadcast(Set.HealthRegen); } },
+		{ EMOBAAttribute::HealingModifier, &UMOBAAttributeSet::HealingModifier, true, 0.0f, 10.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.HealingModifierChange.Broadcast(Set.HealingModifier); } },
+		{ EMOBAAttribute::Mana, &UMOBAAttributeSet::Mana, true, 0.0f, 0.0f, EMOBAAttribute::MaxMana, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.ManaChange.Broadcast(Set.Mana, Set.MaxMana); } },
+		{ EMOBAAttribute::MaxMana, &UMOBAAttributeSet::MaxMana, false, 0.0f, 0.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::ManaRegen, &UMOBAAttributeSet::ManaRegen, true, 0.0f, 5000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.ManaRegenChange.Broadcast(Set.ManaRegen); } },
+		{ EMOBAAttribute::Level, &UMOBAAttributeSet::Level, true, 1.0f, 0.0f, EMOBAAttribute::MaxLevel, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.LevelChange.Broadcast(Set.Level, Set.MaxLevel); } },
+		{ EMOBAAttribute::MaxLevel, &UMOBAAttributeSet::MaxLevel, false, 0.0f, 0.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::Experience, &UMOBAAttributeSet::Experience, false, 0.0f, 0.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.ExperienceChange.Broadcast(Set.Experience, Set.MaxExperience); } },
+		{ EMOBAAttribute::MaxExperience, &UMOBAAttributeSet::MaxExperience, false, 0.0f, 0.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::AttackPower, &UMOBAAttributeSet::AttackPower, true, 0.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.AttackPowerChange.Broadcast(Set.AttackPower); } },
+		{ EMOBAAttribute::SpellPower, &UMOBAAttributeSet::SpellPower, true, 0.0f, 2000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.SpellPowerChange.Broadcast(Set.SpellPower); } },
+		{ EMOBAAttribute::MainHandMinDamage, &UMOBAAttributeSet::MainHandMinDamage, true, 1.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::MainHandMaxDamage, &UMOBAAttributeSet::MainHandMaxDamage, true, 1.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::MainHandAttackSpeed, &UMOBAAttributeSet::MainHandAttackSpeed, true, 0.0f, 2.5f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::MainHandAttackRange, &UMOBAAttributeSet::MainHandAttackRange, true, 150.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::OffHandMinDamage, &UMOBAAttributeSet::OffHandMinDamage, true, 1.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::OffHandMaxDamage, &UMOBAAttributeSet::OffHandMaxDamage, true, 1.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::OffHandAttackSpeed, &UMOBAAttributeSet::OffHandAttackSpeed, true, 0.0f, 2.5f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::OffHandAttackRange, &UMOBAAttributeSet::OffHandAttackRange, true, 150.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX, nullptr },
+		{ EMOBAAttribute::BonusAttackSpeed, &UMOBAAttributeSet::BonusAttackSpeed, true, 0.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.BonusAttackSpeedChange.Broadcast(Set.BonusAttackSpeed); } },
+		{ EMOBAAttribute::CriticalChance, &UMOBAAttributeSet::CriticalChance, true, 0.0f, 1.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.CriticalChanceChange.Broadcast(Set.CriticalChance); } },
+		{ EMOBAAttribute::CriticalDamage, &UMOBAAttributeSet::CriticalDamage, true, 0.0f, 10.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.CriticalDamageChange.Broadcast(Set.CriticalDamage); } },
+		{ EMOBAAttribute::Armor, &UMOBAAttributeSet::Armor, false, 0.0f, 0.0f, EMOBAAttribute::MAX, EMOBAAttribute::PhysicalDamageReduction,
+			[](UMOBAAttributeSet& Set) { Set.ArmorChange.Broadcast(Set.Armor); } },
+		{ EMOBAAttribute::PhysicalDamageReduction, &UMOBAAttributeSet::PhysicalDamageReduction, true, -1.0f, 1.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.PhysicalDamageReductionChange.Broadcast(Set.PhysicalDamageReduction); } },
+		{ EMOBAAttribute::EnvironmentalResistance, &UMOBAAttributeSet::EnvironmentalResistance, false, 0.0f, 0.0f, EMOBAAttribute::MAX, EMOBAAttribute::EnvironmentalDamageReduction,
+			[](UMOBAAttributeSet& Set) { Set.EnvironmentalResistanceChange.Broadcast(Set.EnvironmentalResistance); } },
+		{ EMOBAAttribute::EnvironmentalDamageReduction, &UMOBAAttributeSet::EnvironmentalDamageReduction, true, -1.0f, 1.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.EnvironmentalDamageReductionChange.Broadcast(Set.EnvironmentalDamageReduction); } },
+		{ EMOBAAttribute::FlatDamageReduction, &UMOBAAttributeSet::FlatDamageReduction, true, -1.0f, 1.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.FlatDamageReductionChange.Broadcast(Set.FlatDamageReduction); } },
+		{ EMOBAAttribute::MovementSpeed, &UMOBAAttributeSet::MovementSpeed, true, 0.0f, 1000.0f, EMOBAAttribute::MAX, EMOBAAttribute::MAX,
+			[](UMOBAAttributeSet& Set) { Set.MovementSpeedChange.Broadcast(Set.MovementSpeed); } },
+	};
+	static_assert(UE_ARRAY_COUNT(AttributeDescriptors) == static_cast<int32>(EMOBAAttribute::MAX), "Every EMOBAAttribute needs a descriptor");
+
+	// Maps each attribute property of UMOBAAttributeSet to its EMOBAAttribute. Keyed by property, so member order and layout don't matter.
+	struct FMOBAAttributeLookup
+	{
+		TMap<const FProperty*, EMOBAAttribute> PropertyToAttribute;
+
+		FMOBAAttributeLookup()
+		{
+			const UMOBAAttributeSet* Defaults = GetDefault<UMOBAAttributeSet>();
+			for (int32 Index = 0; Index < UE_ARRAY_COUNT(AttributeDescriptors); Index++)
+			{
+				check(static_cast<int32>(AttributeDescriptors[Index].Attribute) == Index);
+				const int32 Offset = static_cast<int32>(reinterpret_cast<const uint8*>(&(Defaults->*AttributeDescriptors[Index].Member)) - reinterpret_cast<const uint8*>(Defaults));
+				for (TFieldIterator<FStructProperty> It(UMOBAAttributeSet::StaticClass()); It; ++It)
+				{
+					if (It->Struct == FGameplayAttributeData::StaticStruct() && It->GetOffset_ForInternal() == Offset)
+					{
+						PropertyToAttribute.Add(*It, AttributeDescriptors[Index].Attribute);
+						break;
+					}
+				}
+			}
+			// Every descriptor member must be a reflected attribute property
+			checkf(PropertyToAttribute.Num() == UE_ARRAY_COUNT(AttributeDescriptors), TEXT("An attribute descriptor has no matching UPROPERTY in UMOBAAttributeSet"));
+		}
+	};
+}
+
+EMOBAAttribute UMOBAAttributeSet::FindAttribute(const FGameplayAttribute& Attribute)
+{
+	static const FMOBAAttributeLookup Lookup;
+	// Properties are shared with subclasses, so attributes inherited from this set are found too
+	const EMOBAAttribute* Found = Lookup.PropertyToAttribute.Find(Attribute.GetUProperty());
+	return Found ? *Found : EMOBAAttribute::MAX;
+}
+
+const FMOBAAttributeDescriptor& UMOBAAttributeSet::GetAttributeDescriptor(EMOBAAttribute Attribute)
+{
+	check(Attribute != EMOBAAttribute::MAX);
+	return AttributeDescriptors[static_cast<int32>(Attribute)];
+}
+
+void UMOBAAttributeSet::ClampAttribute(const FMOBAAttributeDescriptor& Descriptor)
+{
+	if (!Descriptor.bClamp) return;
+	const float MaxValue = Descriptor.MaxValueAttribute != EMOBAAttribute::MAX ? (this->*GetAttributeDescriptor(Descriptor.MaxValueAttribute).Member).GetCurrentValue() : Descriptor.MaxValue;
+	FGameplayAttributeData& AttributeData = this->*Descriptor.Member;
+	AttributeData = FMath::Clamp(AttributeData.GetCurrentValue(), Descriptor.MinValue, MaxValue);
+}
+
+void UMOBAAttributeSet::RecomputeDependentAttribute(const FMOBAAttributeDescriptor& Descriptor, float NewValue)
+{
+	if (Descriptor.DependentAttribute == EMOBAAttribute::MAX) return;
+	const FMOBAAttributeDescriptor& Dependent = GetAttributeDescriptor(Descriptor.DependentAttribute);
+	(this->*Dependent.Member).SetCurrentValue(CalculateDamageReduction(NewValue));
+	MarkAttributeDirty(Descriptor.DependentAttribute);
+}
+
+void UMOBAAttributeSet::MarkAttributeDirty(EMOBAAttribute Attribute)
+{
+	UWorld* World = GetOwningActor() ? GetOwningActor()->GetWorld() : nullptr;
+	UMOBAAttributeNotificationSubsystem* NotificationSubsystem = World ? World->GetSubsystem<UMOBAAttributeNotificationSubsystem>() : nullptr;
+	if (!bCoalesceNotifications || !NotificationSubsystem)
+	{
+		// Immediate mode, fire the attribute's own delegate right away
+		const FMOBAAttributeDescriptor& Descriptor = GetAttributeDescriptor(Attribute);
+		if (Descriptor.Broadcast) Descriptor.Broadcast(*this);
+		return;
+	}
+	// First change this frame, ask to be flushed at the end of the frame
+	if (DirtyAttributes == 0) NotificationSubsystem->QueueFlush(this);
+	DirtyAttributes |= 1u << static_cast<uint32>(Attribute);
+}
+
+void UMOBAAttributeSet::FlushAttributeNotifications()
+{
+	if (DirtyAttributes == 0) return;
+	const int32 ChangedAttributesMask = static_cast<int32>(DirtyAttributes);
+	DirtyAttributes = 0;
+	AttributesChange.Broadcast(ChangedAttributesMask);
+}
+
+TArray<EMOBAAttribute> UMOBAAttributeSet::GetAttributesFromMask(int32 ChangedAttributesMask)
+{
+	TArray<EMOBAAttribute> ChangedAttributes;
+	uint32 RemainingBits = static_cast<uint32>(ChangedAttributesMask);
+	while (RemainingBits)
 	{
-		damagereduction = 1 - (2 - (100 / (100 - ResistanceStat)));
+		const uint32 Index = FMath::CountTrailingZeros(RemainingBits);
+		ChangedAttributes.Add(static_cast<EMOBAAttribute>(Index));
+		RemainingBits &= RemainingBits - 1;
 	}
-	return damagereduction;
+	return ChangedAttributes;
 }
 
 void UMOBAAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) 
 {
-	
-	if (Attribute == HealthAttribute()) 
+	const EMOBAAttribute ChangedAttribute = FindAttribute(Attribute);
+	switch (ChangedAttribute)
 	{
+	case EMOBAAttribute::Health:
 		Health = FMath::Clamp(NewValue, 0.0f, MaxHealth.GetCurrentValue());
-		HealthChange.Broadcast(Health, MaxHealth);
-	}
-	if (Attribute == MaxHealthAttribute())
-	{
+		MarkAttributeDirty(ChangedAttribute);
+		break;
+	case EMOBAAttribute::MaxHealth:
 		MaxHealth = FMath::Clamp(NewValue, 1.0f, 2147483647.0f);
-		HealthChange.Broadcast(Health, MaxHealth);
-	}
-	if (Attribute == ArmorAttribute()) 
-	{
-		ArmorChange.Broadcast(NewValue);
-	}
-	if (Attribute == HealthRegenAttribute()) 
-	{
+		MarkAttributeDirty(ChangedAttribute);
+		break;
+	case EMOBAAttribute::HealthRegen:
 		HealthRegen = FMath::Clamp(NewValue, 0.0f, 5000.0f);
-		HealthRegenChange.Broadcast(HealthRegen);
+		MarkAttributeDirty(ChangedAttribute);
+		break;
+	case EMOBAAttribute::Armor:
+	case EMOBAAttribute::EnvironmentalResistance:
+		// Resistances from duration effects never reach PostGameplayEffectExecute, keep their damage reduction current here
+		RecomputeDependentAttribute(GetAttributeDescriptor(ChangedAttribute), NewValue);
+		// The new value is not applied yet, so immediate listeners get it passed explicitly
+		if (bCoalesceNotifications) MarkAttributeDirty(ChangedAttribute);
+		else if (ChangedAttribute == EMOBAAttribute::Armor) ArmorChange.Broadcast(NewValue);
+		else EnvironmentalResistanceChange.Broadcast(NewValue);
+		break;
+	default: break;
 	}
-	/*
-	FGameplayAttribute HealingModifierAttribute();
-	FGameplayAttribute ManaAttribute();
-	FGameplayAttribute ManaRegenAttribute();
-	FGameplayAttribute LevelAttribute();
-	FGameplayAttribute ExperienceAttribute();
-	FGameplayAttribute AttackPowerAttribute();
-	FGameplayAttribute SpellPowerAttribute();
-	FGameplayAttribute MainHandAttackSpeedAttribute();
-	FGameplayAttribute OffHandAttackSpeedAttribute();
-	FGameplayAttribute BonusAttackSpeedAttribute();
-	FGameplayAttribute MainHandMinDamageAttribute();
-	FGameplayAttribute MainHandMaxDamageAttribute();
-	FGameplayAttribute OffHandMinDamageAttribute();
-	FGameplayAttribute OffHandMaxDamageAttribute();
-	FGameplayAttribute CriticalChanceAttribute();
-	FGameplayAttribute CriticalDamageAttribute();
-	FGameplayAttribute MainHandAttackRangeAttribute();
-	FGameplayAttribute OffHandAttackRangeAttribute();
-	FGameplayAttribute PhysicalDamageReductionAttribute();
-	FGameplayAttribute EnvironmentalResistanceAttribute();
-	FGameplayAttribute EnvironmentalDamageReductionAttribute();
-	FGameplayAttribute FlatDamageReductionAttribute();
-	FGameplayAttribute MovementSpeedAttribute();
-	*/
 }
 
 void UMOBAAttributeSet::PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data)
 {
 	UAbilitySystemComponent* Source = Data.EffectSpec.GetContext().GetOriginalInstigatorAbilitySystemComponent();
-	AMOBACharacter* SourceActor = Cast<AMOBACharacter>(Source->GetOwner());
+	AMOBACharacter* SourceActor = Source ? Cast<AMOBACharacter>(Source->GetOwner()) : nullptr;
 	AMOBACharacter* MyActor = Cast<AMOBACharacter>(this->GetOwningActor());
 	// Check and see if the source actor is hostile, meaning this gameplay effect was offensive
 	if (MyActor && SourceActor && MyActor->IsHostile(SourceActor)) 
 	{
-		// Set both the source and target in combat and let everyone know
-		MyActor->bIsInCombat = true;
-		MyActor->CombatStatusChangeDelegate.Broadcast(MyActor->bIsAttacking, MyActor->bIsInCombat);
-		SourceActor->bIsInCombat = true;
-		SourceActor->CombatStatusChangeDelegate.Broadcast(SourceActor->bIsAttacking, SourceActor->bIsInCombat);
+		// Set both the source and target in combat, listeners only hear about it when they enter combat
+		MyActor->RefreshCombat();
+		SourceActor->RefreshCombat();
 	}
-	if (HealthAttribute() == Data.EvaluatedData.Attribute)
-	{
-		// Get the Target actor
-		AActor* DamagedActor = nullptr;
-		AController* DamagedController = nullptr;
-		if (Data.Target.AbilityActorInfo.IsValid() && Data.Target.AbilityActorInfo->AvatarActor.IsValid())
-		{
-			DamagedActor = Data.Target.AbilityActorInfo->AvatarActor.Get();
-			DamagedController = Data.Target.AbilityActorInfo->PlayerController.Get();
-		}
 
-		// Get the Source actor
-		AActor* AttackingActor = nullptr;
-		AController* AttackingController = nullptr;
-		AController* AttackingPlayerController = nullptr;
-		if (Source && Source->AbilityActorInfo.IsValid() && Source->AbilityActorInfo->AvatarActor.IsValid())
-		{
-			AttackingActor = Source->AbilityActorInfo->AvatarActor.Get();
-			AttackingController = Source->AbilityActorInfo->PlayerController.Get();
-			AttackingPlayerController = Source->AbilityActorInfo->PlayerController.Get();
-			if (AttackingController == nullptr && AttackingActor != nullptr)
-			{
-				if (APawn * Pawn = Cast<APawn>(AttackingActor))
-				{
-					AttackingController = Pawn->GetController();
-				}
-			}
-		}
+	// One table lookup instead of comparing against every attribute
+	const EMOBAAttribute ChangedAttribute = FindAttribute(Data.EvaluatedData.Attribute);
+	if (ChangedAttribute == EMOBAAttribute::MAX) return;
+	const FMOBAAttributeDescriptor& Descriptor = GetAttributeDescriptor(ChangedAttribute);
+	ClampAttribute(Descriptor);
 
-		// Clamp health
-		Health = FMath::Clamp(Health.GetCurrentValue(), 0.0f, MaxHealth.GetCurrentValue());
+	// Attributes that need more than a clamp
+	switch (ChangedAttribute)
+	{
+	case EMOBAAttribute::Health:
 		if (Health.GetCurrentValue() <= 0)
 		{
 			/*
@@ -168,151 +287,51 @@ void UMOBAAttributeSet::PostGameplayEffectExecute(const struct FGameplayEffectMo
 
 				GASChar->Die(DamagedController, DamagedActor, Data.EffectSpec, Params.RawMagnitude, Params.Normal);
 			}*/
-			
 		}
-		HealthChange.Broadcast(Health, MaxHealth);
-	}
-	if (MaxHealthAttribute() == Data.EvaluatedData.Attribute)
-	{
-		MaxHealth = FMath::Clamp(MaxHealth.GetCurrentValue(), 1.0f, 2147483647.0f);
-		HealthChange.Broadcast(Health, MaxHealth);
-	}
-	if (HealthRegenAttribute() == Data.EvaluatedData.Attribute) 
-	{
-		HealthRegen = FMath::Clamp(HealthRegen.GetCurrentValue(), 0.0f, 5000.0f);
-		HealthRegenChange.Broadcast(HealthRegen);
-	}
-	if (HealingModifierAttribute() == Data.EvaluatedData.Attribute)
-	{
-		HealingModifier = FMath::Clamp(HealingModifier.GetCurrentValue(), 0.0f, 10.0f);
-		HealingModifierChange.Broadcast(HealingModifier);
-	}
-	if (ManaAttribute() == Data.EvaluatedData.Attribute)
-	{
-		Mana = FMath::Clamp(Mana.GetCurrentValue(), 0.0f, MaxMana.GetCurrentValue());
-		ManaChange.Broadcast(Mana, MaxMana);
-	}
-	if (ManaRegenAttribute() == Data.EvaluatedData.Attribute)
-	{
-		ManaRegen = FMath::Clamp(ManaRegen.GetCurrentValue(), 0.0f, 5000.0f);
-		ManaRegenChange.Broadcast(ManaRegen);
-	}
-	if (LevelAttribute() == Data.EvaluatedData.Attribute) 
-	{
-		Level = FMath::Clamp(Level.GetCurrentValue(), 1.0f, MaxLevel.GetCurrentValue());
+		break;
+	case EMOBAAttribute::Level:
 		if (Level.GetCurrentValue() == MaxLevel.GetCurrentValue()) 
 		{
 			Experience = 0;
 			MaxExperience = 0;
 		}
-		LevelChange.Broadcast(Level, MaxLevel);
-	}
-	if (ExperienceAttribute() == Data.EvaluatedData.Attribute)
-	{
+		break;
+	case EMOBAAttribute::Experience:
 		if (Level.GetCurrentValue() < MaxLevel.GetCurrentValue()) {		// Only check XP if level is less than max level
-			FString currentlevelstring = FString::FromInt(static_cast<int32>(Level.GetCurrentValue()));	// Get current level as a string
-			FExperiencePerLevel* XPToLvl = ExperiencePerLevelData->FindRow<FExperiencePerLevel>(FName(*currentlevelstring), "Experience Per Level", true); // Grab the row for the current level
-			if (XPToLvl)
+			if (ExperienceToNextLevel.Num() == 0) CacheExperiencePerLevel();
+			const int32 StartingLevel = static_cast<int32>(Level.GetCurrentValue());
+			const int32 LevelCap = static_cast<int32>(MaxLevel.GetCurrentValue());
+			int32 NewLevel = StartingLevel;
+			float RemainingExperience = Experience.GetCurrentValue();
+			// Spend the grant on as many levels as it covers
+			while (NewLevel < LevelCap && ExperienceToNextLevel.IsValidIndex(NewLevel) && ExperienceToNextLevel[NewLevel] > 0.0f && RemainingExperience >= ExperienceToNextLevel[NewLevel])
+			{
+				RemainingExperience -= ExperienceToNextLevel[NewLevel];
+				NewLevel++;
+			}
+			if (NewLevel != StartingLevel)
 			{
-				if (Experience.GetCurrentValue() >= XPToLvl->Experience) // Check if we have enough experience for a level up
+				Level = NewLevel;
+				if (NewLevel >= LevelCap)
 				{
-					Experience = Experience.GetCurrentValue() - XPToLvl->Experience;
-					Level = (Level.GetCurrentValue() + 1);
-					LevelChange.Broadcast(Level, MaxLevel);
-					currentlevelstring = FString::FromInt(static_cast<int32>(Level.GetCurrentValue()));	// Get current level as a string
-					XPToLvl = ExperiencePerLevelData->FindRow<FExperiencePerLevel>(FName(*currentlevelstring), "Experience Per Level", true); // Grab the row for the current level
-					MaxExperience = XPToLvl->Experience;
+					Experience = 0;
+					MaxExperience = 0;
 				}
+				else
+				{
+					Experience = RemainingExperience;
+					MaxExperience = ExperienceToNextLevel.IsValidIndex(NewLevel) ? ExperienceToNextLevel[NewLevel] : 0.0f;
+				}
+				MarkAttributeDirty(EMOBAAttribute::Level);	// One level change no matter how many levels were gained
 			}
 		}
 		else Experience = FMath::Clamp(Experience.GetCurrentValue(), 0.0f, 0.0f);
-		ExperienceChange.Broadcast(Experience, MaxExperience);
-	}
-	if (AttackPowerAttribute() == Data.EvaluatedData.Attribute)
-	{
-		AttackPower = FMath::Clamp(AttackPower.GetCurrentValue(), 0.0f, 1000.0f);
-		AttackPowerChange.Broadcast(AttackPower);
-	}
-	if (SpellPowerAttribute() == Data.EvaluatedData.Attribute)
-	{
-		SpellPower = FMath::Clamp(SpellPower.GetCurrentValue(), 0.0f, 2000.0f);
-		SpellPowerChange.Broadcast(SpellPower);
-	}
-	if (MainHandMinDamageAttribute() == Data.EvaluatedData.Attribute)
-	{
-		MainHandMinDamage = FMath::Clamp(MainHandMinDamage.GetCurrentValue(), 1.0f, 1000.0f);
-	}
-	if (OffHandMinDamageAttribute() == Data.EvaluatedData.Attribute)
-	{
-		OffHandMinDamage = FMath::Clamp(OffHandMinDamage.GetCurrentValue(), 1.0f, 1000.0f);
-	}
-	if (MainHandMaxDamageAttribute() == Data.EvaluatedData.Attribute)
-	{
-		MainHandMaxDamage = FMath::Clamp(MainHandMaxDamage.GetCurrentValue(), 1.0f, 1000.0f);
-	}
-	if (OffHandMaxDamageAttribute() == Data.EvaluatedData.Attribute)
-	{
-		OffHandMaxDamage = FMath::Clamp(OffHandMaxDamage.GetCurrentValue(), 1.0f, 1000.0f);
-	}
-	if (MainHandAttackRangeAttribute() == Data.EvaluatedData.Attribute)
-	{
-		MainHandAttackRange = FMath::Clamp(MainHandAttackRange.GetCurrentValue(), 150.0f, 1000.0f);
-	}
-	if (OffHandAttackRangeAttribute() == Data.EvaluatedData.Attribute)
-	{
-		OffHandAttackRange = FMath::Clamp(OffHandAttackRange.GetCurrentValue(), 150.0f, 1000.0f);
-	}
-	if (MainHandAttackSpeedAttribute() == Data.EvaluatedData.Attribute)
-	{
-		MainHandAttackSpeed = FMath::Clamp(MainHandAttackSpeed.GetCurrentValue(), 0.0f, 2.5f);
-	}
-	if (OffHandAttackSpeedAttribute() == Data.EvaluatedData.Attribute)
-	{
-		OffHandAttackSpeed = FMath::Clamp(OffHandAttackSpeed.GetCurrentValue(), 0.0f, 2.5f);
-	}
-	if (BonusAttackSpeedAttribute() == Data.EvaluatedData.Attribute)
-	{
-		BonusAttackSpeed = FMath::Clamp(BonusAttackSpeed.GetCurrentValue(), 0.0f, 1000.0f);
-		BonusAttackSpeedChange.Broadcast(BonusAttackSpeed);
-	}
-	if (CriticalChanceAttribute() == Data.EvaluatedData.Attribute)
-	{
-		CriticalChance = FMath::Clamp(CriticalChance.GetCurrentValue(), 0.0f, 1.0f);
-		CriticalChanceChange.Broadcast(CriticalChance);
-	}
-	if (CriticalDamageAttribute() == Data.EvaluatedData.Attribute)
-	{
-		CriticalDamage = FMath::Clamp(CriticalDamage.GetCurrentValue(), 0.0f, 10.0f);
-		CriticalDamageChange.Broadcast(CriticalDamage);
-	}
-	if (ArmorAttribute() == Data.EvaluatedData.Attribute)
-	{
-		ArmorChange.Broadcast(Armor);
-	}
-	if (PhysicalDamageReductionAttribute() == Data.EvaluatedData.Attribute) 
-	{
-		PhysicalDamageReduction = FMath::Clamp(PhysicalDamageReduction.GetCurrentValue(), -1.0f, 1.0f);
-		PhysicalDamageReductionChange.Broadcast(PhysicalDamageReduction);
-	}
-	if (EnvironmentalResistanceAttribute() == Data.EvaluatedData.Attribute)
-	{
-		EnvironmentalResistanceChange.Broadcast(EnvironmentalResistance);
-	}
-	if (EnvironmentalDamageReductionAttribute() == Data.EvaluatedData.Attribute)
-	{
-		EnvironmentalDamageReduction = FMath::Clamp(EnvironmentalDamageReduction.GetCurrentValue(), -1.0f, 1.0f);
-		EnvironmentalDamageReductionChange.Broadcast(EnvironmentalDamageReduction);
-	}
-	if (FlatDamageReductionAttribute() == Data.EvaluatedData.Attribute)
-	{
-		FlatDamageReduction = FMath::Clamp(FlatDamageReduction.GetCurrentValue(), -1.0f, 1.0f);
-		FlatDamageReductionChange.Broadcast(FlatDamageReduction);
-	}
-	if (MovementSpeedAttribute() == Data.EvaluatedData.Attribute)
-	{
-		MovementSpeed = FMath::Clamp(MovementSpeed.GetCurrentValue(), 0.0f, 1000.0f);
-		MovementSpeedChange.Broadcast(MovementSpeed);
+		break;
+	default: break;
 	}
+
+	RecomputeDependentAttribute(Descriptor, (this->*Descriptor.Member).GetCurrentValue());
+	MarkAttributeDirty(ChangedAttribute);
 }
 
 FGameplayAttribute UMOBAAttributeSet::HealthAttribute()
@@ -19,6 +19,49 @@
  * 
  */
 
+// Every attribute owned by UMOBAAttributeSet, in declaration order. Indexes the attribute descriptor table.
+UENUM(BlueprintType)
+enum class EMOBAAttribute : uint8
+{
+	Health							UMETA(DisplayName = "Health"),
+	MaxHealth						UMETA(DisplayName = "Max Health"),
+	HealthRegen						UMETA(DisplayName = "Health Regen"),
+	HealingModifier					UMETA(DisplayName = "Healing Modifier"),
+	Mana							UMETA(DisplayName = "Mana"),
+	MaxMana							UMETA(DisplayName = "Max Mana"),
+	ManaRegen						UMETA(DisplayName = "Mana Regen"),
+	Level							UMETA(DisplayName = "Level"),
+	MaxLevel						UMETA(DisplayName = "Max Level"),
+	Experience						UMETA(DisplayName = "Experience"),
+	MaxExperience					UMETA(DisplayName = "Max Experience"),
+	AttackPower						UMETA(DisplayName = "Attack Power"),
+	SpellPower						UMETA(DisplayName = "Spell Power"),
+	MainHandMinDamage				UMETA(DisplayName = "Main Hand Min Damage"),
+	MainHandMaxDamage				UMETA(DisplayName = "Main Hand Max Damage"),
+	MainHandAttackSpeed				UMETA(DisplayName = "Main Hand Attack Speed"),
+	MainHandAttackRange				UMETA(DisplayName = "Main Hand Attack Range"),
+	OffHandMinDamage				UMETA(DisplayName = "Off Hand Min Damage"),
+	OffHandMaxDamage				UMETA(DisplayName = "Off Hand Max Damage"),
+	OffHandAttackSpeed				UMETA(DisplayName = "Off Hand Attack Speed"),
+	OffHandAttackRange				UMETA(DisplayName = "Off Hand Attack Range"),
+	BonusAttackSpeed				UMETA(DisplayName = "Bonus Attack Speed"),
+	CriticalChance					UMETA(DisplayName = "Critical Chance"),
+	CriticalDamage					UMETA(DisplayName = "Critical Damage"),
+	Armor							UMETA(DisplayName = "Armor"),
+	PhysicalDamageReduction			UMETA(DisplayName = "Physical Damage Reduction"),
+	EnvironmentalResistance			UMETA(DisplayName = "Environmental Resistance"),
+	EnvironmentalDamageReduction	UMETA(DisplayName = "Environmental Damage Reduction"),
+	FlatDamageReduction				UMETA(DisplayName = "Flat Damage Reduction"),
+	MovementSpeed					UMETA(DisplayName = "Movement Speed"),
+	MAX								UMETA(Hidden)
+};
+
+struct FMOBAAttributeDescriptor;
+
+static_assert(static_cast<uint32>(EMOBAAttribute::MAX) <= 31, "EMOBAAttribute must fit in the int32 dirty attribute mask");
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAttributesChange, int32, ChangedAttributesMask);	// One bit per EMOBAAttribute
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHealthChange, FGameplayAttributeData, Health, FGameplayAttributeData, MaxHealth);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHealthRegenChange, FGameplayAttributeData, HealthRegen);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHealingModifierChange, FGameplayAttributeData, HealingModifier);
@@ -141,11 +184,34 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attributes | Experience", meta = (AllowPrivateAccess = "true"))
 		class UDataTable* ExperiencePerLevelData;
 
+	// Experience needed to advance from each level, indexed by level. Flattened from ExperiencePerLevelData once at load.
+	TArray<float> ExperienceToNextLevel;
+
+	// Rebuild ExperienceToNextLevel from ExperiencePerLevelData
+	void CacheExperiencePerLevel();
+
 	float CalculateDamageReduction(float ResistanceStat);
 	
 	// Event handlers for when attributes change
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data);
+
+	// When true, attribute changes only set a dirty bit and AttributesChange fires once at the end of the frame.
+	// When false, every change fires its own delegate immediately.
+	bool bCoalesceNotifications = false;
+
+	// Mark an attribute as changed, either broadcasting right away or deferring to the end of frame flush
+	void MarkAttributeDirty(EMOBAAttribute Attribute);
+
+	// Broadcast AttributesChange for everything marked dirty since the last flush. Called by UMOBAAttributeNotificationSubsystem.
+	void FlushAttributeNotifications();
+
+	// Expand an AttributesChange mask into the attributes it contains
+	static TArray<EMOBAAttribute> GetAttributesFromMask(int32 ChangedAttributesMask);
+
+	// Attribute descriptor table lookups. FindAttribute returns EMOBAAttribute::MAX for attributes this set does not own.
+	static EMOBAAttribute FindAttribute(const FGameplayAttribute& Attribute);
+	static const FMOBAAttributeDescriptor& GetAttributeDescriptor(EMOBAAttribute Attribute);
 	
 	// Attributes
 	FGameplayAttribute HealthAttribute();
@@ -177,6 +243,7 @@ public:
 	FGameplayAttribute MovementSpeedAttribute();
 
 	// Attribute Delegates
+	FAttributesChange AttributesChange;
 	FHealthChange HealthChange;
 	FHealthRegenChange HealthRegenChange;
 	FHealingModifierChange HealingModifierChange;
@@ -197,4 +264,26 @@ public:
 	FEnvironmentalDamageReductionChange EnvironmentalDamageReductionChange;
 	FFlatDamageReductionChange FlatDamageReductionChange;
 	FMovementSpeedChange MovementSpeedChange;
+
+protected:
+	// Attributes changed since the last flush, one bit per EMOBAAttribute
+	uint32 DirtyAttributes = 0;
+
+	// Clamp an attribute to the range in its descriptor
+	void ClampAttribute(const FMOBAAttributeDescriptor& Descriptor);
+	// Recompute the attribute derived from this one (e.g. Armor -> PhysicalDamageReduction)
+	void RecomputeDependentAttribute(const FMOBAAttributeDescriptor& Descriptor, float NewValue);
+};
+
+// Static description of how an attribute is post-processed after a gameplay effect modifies it
+struct FMOBAAttributeDescriptor
+{
+	EMOBAAttribute Attribute;
+	FGameplayAttributeData UMOBAAttributeSet::* Member;
+	bool bClamp;
+	float MinValue;
+	float MaxValue;
+	EMOBAAttribute MaxValueAttribute;		// Upper bound taken from another attribute instead of MaxValue, MAX if unused
+	EMOBAAttribute DependentAttribute;		// Damage reduction attribute derived from this resistance, MAX if unused
+	void (*Broadcast)(UMOBAAttributeSet&);	// Fires the attribute's change delegate, nullptr if it has none
 };
\ No newline at end of file
@@ -14,6 +14,13 @@
 #include "Engine/World.h"
 #include "MOBAGameplayAbility.h"
 #include "GameplayTagContainer.h"
+#include "MOBARegenerationSubsystem.h"
+#include "MOBAGameMode.h"
+#include "MOBACombatTimerSubsystem.h"
+#include "MOBACharacterRegistrySubsystem.h"
+#include "MOBAProjectilePoolSubsystem.h"
+#include "MOBAPathRequestSubsystem.h"
+#include "GameFramework/GameStateBase.h"
 
 AMOBACharacter::AMOBACharacter()
 {
@@ -31,6 +38,9 @@ AMOBACharacter::AMOBACharacter()
 	GetCharacterMovement()->bConstrainToPlane = true;
 	GetCharacterMovement()->bSnapToPlaneAtStart = true;
 
+	// Range checks and projectile hits use distance or the capsule, the mesh never needs overlap events
+	GetMesh()->SetGenerateOverlapEvents(false);
+
 	// Activate ticking in order to update the cursor every frame.
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
@@ -38,6 +48,7 @@ AMOBACharacter::AMOBACharacter()
 	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>("Ability System Component");
 	AttributeSet = CreateDefaultSubobject<UMOBAAttributeSet>("Attribute Set");
 	EquipmentComponent = CreateDefaultSubobject<UEquipmentComponent>("Equipment");
+	CooldownTracker = CreateDefaultSubobject<UMOBACooldownTrackerComponent>("Cooldown Tracker");
 
 	// Set Default Combat Values
 	bIsAttacking = false;
@@ -72,7 +83,16 @@ void AMOBACharacter::AcquireAbility(TSubclassOf<UGameplayAbility> AbilityToAcqui
 {
 	if (AbilitySystemComponent) 
 	{
-		if (HasAuthority() && AbilityToAcquire)
+		// Regeneration is handled by the regeneration subsystem, don't run the periodic regen abilities as well
+		static const FGameplayTag HealthRegenTag = FGameplayTag::RequestGameplayTag(FName("Abilities.Basic.HealthRegen"));
+		static const FGameplayTag ManaRegenTag = FGameplayTag::RequestGameplayTag(FName("Abilities.Basic.ManaRegen"));
+		bool bReplacedByRegenerationSubsystem = false;
+		if (bUseRegenerationSubsystem && AbilityToAcquire)
+		{
+			const FGameplayTagContainer& AbilityTags = AbilityToAcquire->GetDefaultObject<UGameplayAbility>()->AbilityTags;
+			bReplacedByRegenerationSubsystem = AbilityTags.HasTagExact(HealthRegenTag) || AbilityTags.HasTagExact(ManaRegenTag);
+		}
+		if (HasAuthority() && AbilityToAcquire && !bReplacedByRegenerationSubsystem)
 		{
 			FGameplayAbilitySpecDef SpecDef = FGameplayAbilitySpecDef();
 			SpecDef.Ability = AbilityToAcquire;
@@ -105,17 +125,7 @@ void AMOBACharacter::RemoveAbility(TSubclassOf<UGameplayAbility> AbilityToRemove
 // Check if we can perform a basic attack
 float AMOBACharacter::GetBasicAttackCooldown() 
 {
-	if (AbilitySystemComponent) 
-	{
-		FGameplayTagContainer CooldownContainer;
-		FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Abilities.Basic.BasicAttack.Cooldown")));
-		CooldownContainer.AddTag(CooldownTag);
-		FGameplayEffectQuery MyQuery = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(CooldownContainer);
-		if (AbilitySystemComponent->GetActiveEffectsTimeRemaining(MyQuery).Num() > 0) 
-		{
-			return (AbilitySystemComponent->GetActiveEffectsTimeRemaining(MyQuery)).Last();
-		}
-	}
+	if (CooldownTracker) return CooldownTracker->GetBasicAttackCooldownRemaining();
 	return 0.0f;
 }
 
@@ -135,16 +145,179 @@ bool AMOBACharacter::GetOffHandWeaponEquipped()
 	return false;
 }
 
-// Check and see if another character is hostile (should we allow attacks or abilities on this target)
-bool AMOBACharacter::IsHostile(AMOBACharacter* TargetCharacter)
+USphereComponent* AMOBACharacter::AcquireRangeSphere(float Radius)
+{
+	USphereComponent* RangeSphere = RangeSpherePool.Num() > 0 ? RangeSpherePool.Pop(false) : nullptr;
+	if (!RangeSphere)
+	{
+		RangeSphere = NewObject<USphereComponent>(this);
+		RangeSphere->SetupAttachment(GetRootComponent());
+		RangeSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+		RangeSphere->bHiddenInGame = true;
+		RangeSphere->bMultiBodyOverlap = 1;
+		RangeSphere->RegisterComponent();
+	}
+	RangeSphere->SetSphereRadius(Radius);
+	RangeSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	RangeSphere->SetGenerateOverlapEvents(true);
+	return RangeSphere;
+}
+
+void AMOBACharacter::ReleaseRangeSphere(USphereComponent* RangeSphere)
+{
+	if (!RangeSphere) return;
+	RangeSphere->SetGenerateOverlapEvents(false);
+	RangeSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RangeSpherePool.Add(RangeSphere);
+}
+
+AProjectile* AMOBACharacter::LaunchProjectile(TSubclassOf<AProjectile> InProjectileClass, FTransform SpawnTransform, bool IsSingleTarget, ACharacter* CharacterTarget, FVector Direction, float InMaxDistance)
+{
+	if (!HasAuthority()) return nullptr;
+	AProjectile* Projectile = AcquireProjectileActor(InProjectileClass, SpawnTransform);
+	if (!Projectile) return nullptr;
+	// Speed comes from the projectile's InitialSpeed, the direction only aims it
+	Direction = Direction.GetSafeNormal();
+	Projectile->InitializeProjectile(IsSingleTarget, CharacterTarget, Direction, InMaxDistance);
+	if (!Projectile->bIsInitialized) return nullptr;
+	if (GetNetMode() != NM_Standalone)
+	{
+		Projectile->NetProjectileId = NextProjectileNetId++;
+		Projectile->OnProjectileResolved.AddDynamic(this, &AMOBACharacter::OnLaunchedProjectileResolved);
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		FMOBAProjectileSpawnEvent SpawnEvent;
+		SpawnEvent.ProjectileClass = InProjectileClass;
+		SpawnEvent.ProjectileId = Projectile->NetProjectileId;
+		SpawnEvent.Origin = Projectile->GetActorLocation();
+		SpawnEvent.Direction = CharacterTarget ? (CharacterTarget->GetActorLocation() - SpawnEvent.Origin).GetSafeNormal() : Direction;
+		SpawnEvent.Target = CharacterTarget;
+		SpawnEvent.MaxDistance = InMaxDistance;
+		SpawnEvent.SpawnTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+		SpawnEvent.bIsSingleTarget = IsSingleTarget;
+		MulticastProjectileSpawned(SpawnEvent);
+	}
+	return Projectile;
+}
+
+AProjectile* AMOBACharacter::LaunchBasicAttackProjectile(ACharacter* Target)
 {
-	if (TargetCharacter->IsValidLowLevel() && this->IsValidLowLevel())
+	if (!ProjectileClass || !Target) return nullptr;
+	const FTransform SpawnTransform = (GetMesh() && GetMesh()->DoesSocketExist(ProjectileSpawnSocket)) ? GetMesh()->GetSocketTransform(ProjectileSpawnSocket) : GetActorTransform();
+	return LaunchProjectile(ProjectileClass, SpawnTransform, true, Target);
+}
+
+void AMOBACharacter::MulticastProjectileSpawned_Implementation(const FMOBAProjectileSpawnEvent& SpawnEvent)
+{
+	// The server flies the real projectile
+	if (HasAuthority() || !SpawnEvent.ProjectileClass) return;
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float Latency = GameState ? FMath::Max(GameState->GetServerWorldTimeSeconds() - SpawnEvent.SpawnTime, 0.0f) : 0.0f;
+	FVector Origin = SpawnEvent.Origin;
+	float RemainingDistance = SpawnEvent.MaxDistance;
+	if (!SpawnEvent.Target)
 	{
-		if (this->MyTeam != TargetCharacter->MyTeam && TargetCharacter->MyTeam != ETeam::NeutralFriendly)
+		// Catch a skillshot up to where it is on the server by now
+		const AProjectile* ProjectileDefaults = SpawnEvent.ProjectileClass->GetDefaultObject<AProjectile>();
+		const float Travelled = ProjectileDefaults->ProjectileMovementComponent ? ProjectileDefaults->ProjectileMovementComponent->InitialSpeed * Latency : 0.0f;
+		if (RemainingDistance > 0.0f)
 		{
-			return true;
+			if (Travelled >= RemainingDistance) return;
+			RemainingDistance -= Travelled;
 		}
-		else return false;
+		Origin += SpawnEvent.Direction * Travelled;
+	}
+	AProjectile* Projectile = AcquireProjectileActor(SpawnEvent.ProjectileClass, FTransform(SpawnEvent.Direction.Rotation(), Origin));
+	if (!Projectile) return;
+	Projectile->bIsNetProxy = true;
+	Projectile->NetProjectileId = SpawnEvent.ProjectileId;
+	Projectile->InitializeProjectile(SpawnEvent.bIsSingleTarget, SpawnEvent.Target, SpawnEvent.Direction, RemainingDistance);
+	if (!Projectile->bIsInitialized) return;
+	Projectile->OnProjectileResolved.AddDynamic(this, &AMOBACharacter::OnProxyProjectileResolved);
+	ProxyProjectiles.Add(SpawnEvent.ProjectileId, Projectile);
+}
+
+void AMOBACharacter::MulticastProjectileResolved_Implementation(uint16 ProjectileId, ACharacter* InHitTarget, bool bHitTarget)
+{
+	if (HasAuthority()) return;
+	TWeakObjectPtr<AProjectile> Proxy;
+	if (!ProxyProjectiles.RemoveAndCopyValue(ProjectileId, Proxy)) return;
+	AProjectile* Projectile = Proxy.Get();
+	// The copy may have landed or expired on its own already
+	if (Projectile && Projectile->bIsInitialized && Projectile->NetProjectileId == ProjectileId)
+	{
+		Projectile->HitTarget = InHitTarget;
+		Projectile->ResolveProjectile(bHitTarget);
+	}
+}
+
+void AMOBACharacter::OnLaunchedProjectileResolved(AProjectile* Projectile, bool bHitTarget)
+{
+	if (Projectile) MulticastProjectileResolved(Projectile->NetProjectileId, Projectile->HitTarget, bHitTarget);
+}
+
+void AMOBACharacter::OnProxyProjectileResolved(AProjectile* Projectile, bool bHitTarget)
+{
+	if (!Projectile) return;
+	const TWeakObjectPtr<AProjectile>* Proxy = ProxyProjectiles.Find(Projectile->NetProjectileId);
+	if (Proxy && Proxy->Get() == Projectile)
+	{
+		ProxyProjectiles.Remove(Projectile->NetProjectileId);
+	}
+}
+
+AProjectile* AMOBACharacter::AcquireProjectileActor(TSubclassOf<AProjectile> InProjectileClass, const FTransform& SpawnTransform)
+{
+	if (!InProjectileClass) return nullptr;
+	AProjectile* Projectile = nullptr;
+	if (UMOBAProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UMOBAProjectilePoolSubsystem>())
+	{
+		Projectile = Pool->AcquireProjectile(InProjectileClass, SpawnTransform, this, this);
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.Owner = this;
+		SpawnParameters.Instigator = this;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Projectile = GetWorld()->SpawnActor<AProjectile>(InProjectileClass, SpawnTransform, SpawnParameters);
+	}
+	// Launched projectiles travel as spawn and resolve events, the actor itself doesn't need to replicate
+	if (Projectile && Projectile->HasAuthority())
+	{
+		Projectile->SetReplicates(false);
+		Projectile->SetReplicatingMovement(false);
+	}
+	return Projectile;
+}
+
+void AMOBACharacter::PrewarmProjectileActors(TSubclassOf<AProjectile> InProjectileClass, int32 Count)
+{
+	UMOBAProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UMOBAProjectilePoolSubsystem>();
+	if (!Pool || !InProjectileClass) return;
+	TArray<AProjectile*, TInlineAllocator<8>> Prewarmed;
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		if (AProjectile* Projectile = AcquireProjectileActor(InProjectileClass, GetActorTransform())) Prewarmed.Add(Projectile);
+	}
+	for (AProjectile* Projectile : Prewarmed)
+	{
+		Pool->ReleaseProjectile(Projectile);
+	}
+}
+
+FMOBACombatRandom AMOBACharacter::NextCombatRandom()
+{
+	const AMOBAGameMode* GameMode = GetWorld() ? GetWorld()->GetAuthGameMode<AMOBAGameMode>() : nullptr;
+	const uint64 MatchSeed = GameMode ? static_cast<uint64>(GameMode->MatchSeed) : 0;
+	return FMOBACombatRandom(MatchSeed, static_cast<uint32>(CombatRandomId), static_cast<uint32>(CombatRollIndex++));
+}
+
+// Check and see if another character is hostile (should we allow attacks or abilities on this target)
+bool AMOBACharacter::IsHostile(AMOBACharacter* TargetCharacter)
+{
+	if (TargetCharacter)
+	{
+		return UMOBACharacterRegistrySubsystem::IsHostileTeam(MyTeam, TargetCharacter->MyTeam);
 	}
 	else return false;
 }
@@ -162,6 +335,8 @@ void AMOBACharacter::BeginPlay()
 		CombatStatusChangeDelegate.AddDynamic(this, &AMOBACharacter::CombatStatusChange);
 		AttributeSet->PhysicalDamageReduction = AttributeSet->CalculateDamageReduction(AttributeSet->Armor.GetCurrentValue());
 		AttributeSet->EnvironmentalDamageReduction = AttributeSet->CalculateDamageReduction(AttributeSet->EnvironmentalResistance.GetCurrentValue());
+		AttributeSet->bCoalesceNotifications = bCoalesceAttributeNotifications;
+		AttributeSet->AttributesChange.AddDynamic(this, &AMOBACharacter::AttributesChange);
 		AttributeSet->HealthChange.AddDynamic(this, &AMOBACharacter::HealthChange);
 		AttributeSet->HealthRegenChange.AddDynamic(this, &AMOBACharacter::HealthRegenChange);
 		AttributeSet->HealingModifierChange.AddDynamic(this, &AMOBACharacter::HealingModifierChange);
@@ -183,11 +358,38 @@ void AMOBACharacter::BeginPlay()
 		AttributeSet->FlatDamageReductionChange.AddDynamic(this, &AMOBACharacter::FlatDamageReductionChange);
 		AttributeSet->MovementSpeedChange.AddDynamic(this, &AMOBACharacter::MovementSpeedChange);
 	}
+	if (UMOBACharacterRegistrySubsystem* CharacterRegistry = GetWorld()->GetSubsystem<UMOBACharacterRegistrySubsystem>())
+	{
+		CharacterRegistry->RegisterCharacter(this);
+	}
+	// Server projectiles and client copies both come from the pool
+	if (bUseProjectile)
+	{
+		PrewarmProjectileActors(ProjectileClass, BasicAttackProjectilePrewarmCount);
+	}
+	if (HasAuthority())
+	{
+		AMOBAGameMode* GameMode = GetWorld()->GetAuthGameMode<AMOBAGameMode>();
+		CombatRandomId = GameMode ? GameMode->AllocateCombatRandomId() : static_cast<int32>(GetUniqueID());
+	}
+	if (AttributeSet && bUseRegenerationSubsystem && HasAuthority())
+	{
+		if (UMOBARegenerationSubsystem* RegenerationSubsystem = GetWorld()->GetSubsystem<UMOBARegenerationSubsystem>())
+		{
+			RegenerationSubsystem->RegisterAttributeSet(AttributeSet);
+		}
+	}
 	if (AbilitySystemComponent) 
 	{
 		AbilitySystemComponent->OnAbilityEnded.AddUObject(this, &AMOBACharacter::OnAbilityEnded);
 		FOnGivenActiveGameplayEffectRemoved* GameplayEffectRemovedDelegate = &AbilitySystemComponent->OnAnyGameplayEffectRemovedDelegate();
 		GameplayEffectRemovedDelegate->AddUObject(this, &AMOBACharacter::OnGameplayEffectEnd);
+		if (CooldownTracker)
+		{
+			CooldownTracker->Initialize(AbilitySystemComponent);
+			// Basic Attack Cooldown Complete, try basic attack
+			CooldownTracker->OnBasicAttackCooldownEnd.AddDynamic(this, &AMOBACharacter::TryBasicAttack);
+		}
 	}
 	if (EquipmentComponent) 
 	{
@@ -196,13 +398,26 @@ void AMOBACharacter::BeginPlay()
 	}
 }
 
+void AMOBACharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMOBARegenerationSubsystem* RegenerationSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMOBARegenerationSubsystem>() : nullptr)
+	{
+		RegenerationSubsystem->UnregisterAttributeSet(AttributeSet);
+	}
+	if (UMOBACharacterRegistrySubsystem* CharacterRegistry = GetWorld() ? GetWorld()->GetSubsystem<UMOBACharacterRegistrySubsystem>() : nullptr)
+	{
+		CharacterRegistry->UnregisterCharacter(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 void AMOBACharacter::PossessedBy(AController* NewController) 
 {
 	Super::PossessedBy(NewController);
 	AbilitySystemComponent->RefreshAbilityActorInfo();
 }
 
-void AMOBACharacter::InventoryChange(TArray<UItem*> AffectedSlots, TArray<int32> AffectedIndices)
+void AMOBACharacter::InventoryChange(TArray<FItemInstance> AffectedSlots, TArray<int32> AffectedIndices)
 {
 	BP_InventoryChange(AffectedSlots, AffectedIndices);
 }
@@ -210,6 +425,14 @@ void AMOBACharacter::EquipmentChange(uint8 AffectedSlot, UEquipment* EquipmentOb
 {
 	BP_EquipmentChange(ESlotType(AffectedSlot), EquipmentObjRef);
 }
+void AMOBACharacter::AttributesChange(int32 ChangedAttributesMask)
+{
+	if (ChangedAttributesMask & (1 << static_cast<int32>(EMOBAAttribute::MovementSpeed)))
+	{
+		GetCharacterMovement()->MaxWalkSpeed = AttributeSet->MovementSpeed.GetCurrentValue();
+	}
+	BP_AttributesChange(UMOBAAttributeSet::GetAttributesFromMask(ChangedAttributesMask));
+}
 void AMOBACharacter::HealthChange(FGameplayAttributeData health, FGameplayAttributeData maxhealth) 
 {
 	BP_HealthChange(health, maxhealth);
@@ -269,7 +492,6 @@ void AMOBACharacter::CriticalDamageChange(FGameplayAttributeData CriticalDamage)
 
 void AMOBACharacter::ArmorChange(FGameplayAttributeData Armor)
 {
-	AttributeSet->PhysicalDamageReduction.SetCurrentValue(AttributeSet->CalculateDamageReduction(Armor.GetCurrentValue()));
 	BP_ArmorChange(Armor);
 }
 
@@ -280,7 +502,6 @@ void AMOBACharacter::PhysicalDamageReductionChange(FGameplayAttributeData Physic
 
 void AMOBACharacter::EnvironmentalResistanceChange(FGameplayAttributeData EnvironmentalResistance)
 {
-	AttributeSet->EnvironmentalDamageReduction.SetCurrentValue(AttributeSet->CalculateDamageReduction(EnvironmentalResistance.GetCurrentValue()));
 	BP_EnvironmentalResistanceChange(EnvironmentalResistance);
 }
 
@@ -307,10 +528,10 @@ void AMOBACharacter::CombatStatusChange(bool bIsAttackingIn, bool bIsInCombatIn)
 {
 	if (bIsInCombatIn) 
 	{
-		UWorld* World = GetWorld();
-		if (World) 
+		UMOBACombatTimerSubsystem* CombatTimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMOBACombatTimerSubsystem>() : nullptr;
+		if (CombatTimerSubsystem) 
 		{
-			World->GetTimerManager().SetTimer(CombatTimerHandle, this, &AMOBACharacter::CombatTimerCallback, 5.0f, false);
+			CombatTimerSubsystem->NotifyHostileInteraction(this);
 		}
 	}
 	else 
@@ -327,18 +548,7 @@ void AMOBACharacter::OnAbilityEnded(const FAbilityEndedData& AbilityEndData)
 
 void AMOBACharacter::OnGameplayEffectEnd(const FActiveGameplayEffect& EndedGameplayEffect)
 {
-	// Check if the effect was a basic attack cooldown
-	FGameplayTagContainer BasicAttackCooldownTagContainer;
-	FGameplayTagContainer EndedGameplayEffectContainer;
-	FGameplayTag BasicAttackCooldown;
-	BasicAttackCooldown = FGameplayTag::RequestGameplayTag(FName("Abilities.Basic.BasicAttack.Cooldown"));
-	BasicAttackCooldownTagContainer.AddTag(BasicAttackCooldown);
-	EndedGameplayEffect.Spec.GetAllGrantedTags(EndedGameplayEffectContainer);
-	if (EndedGameplayEffectContainer.HasAny(BasicAttackCooldownTagContainer)) 
-	{
-		// Basic Attack Cooldown Complete, try basic attack
-		TryBasicAttack();
-	}	
+	// Basic attack cooldown completion is handled by CooldownTracker
 	BP_OnGameplayEffectEnd(EndedGameplayEffect);
 }
 
@@ -347,8 +557,12 @@ void AMOBACharacter::TryBasicAttack()
 	if (bIsAttacking && MyEnemyTarget) 
 	{
 		float cooldownremaining = GetBasicAttackCooldown();
+		AAIController* MyAIController = Cast<AAIController>(GetController());
+		UMOBAPathRequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UMOBAPathRequestSubsystem>();
 		if (cooldownremaining <= 0)
 		{
+			// The attack takes over from the pursuit used to close in during the cooldown
+			if (MyAIController && PathRequests) PathRequests->CancelMove(MyAIController);
 			if (GetOffHandWeaponEquipped())
 			{
 				BP_TryBasicAttack(bUseOffHandWeapon);
@@ -358,15 +572,29 @@ void AMOBACharacter::TryBasicAttack()
 		}
 		else
 		{
-			AAIController* MyAIController = Cast<AAIController>(GetController());
-			if (MyAIController) 
+			// Close in while waiting for the cooldown
+			if (MyAIController && PathRequests) 
 			{
-				MyAIController->MoveToActor(MyEnemyTarget, 5.0f, false, true, false);
+				PathRequests->RequestPursuit(MyAIController, MyEnemyTarget, 5.0f);
 			}
 		}
 	}
 }
 
+void AMOBACharacter::RefreshCombat()
+{
+	if (!bIsInCombat)
+	{
+		bIsInCombat = true;
+		CombatStatusChangeDelegate.Broadcast(bIsAttacking, bIsInCombat);
+	}
+	else if (UMOBACombatTimerSubsystem* CombatTimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMOBACombatTimerSubsystem>() : nullptr)
+	{
+		// Already in combat, only the timestamp moves
+		CombatTimerSubsystem->NotifyHostileInteraction(this);
+	}
+}
+
 void AMOBACharacter::CombatTimerCallback() 
 {
 	bIsInCombat = false;
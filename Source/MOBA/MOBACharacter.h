@@ -9,6 +9,9 @@
 #include "GameplayAbilitySpec.h"
 #include "Components/SphereComponent.h"
 #include "EquipmentComponent.h"
+#include "MOBAAttributeSet.h"
+#include "MOBACombatRandom.h"
+#include "MOBACooldownTrackerComponent.h"
 #include "Animation/AnimMontage.h"
 #include "MOBACharacter.generated.h"
 
@@ -21,7 +24,7 @@ enum class ETeam : uint8
 	TopSide			UMETA(DisplayName = "Top Side"),
 	NeutralHostile	UMETA(DisplayName = "Jungle Camps"),
 	NeutralFriendly UMETA(DisplayName = "Shop Vendors"),
-
+	MAX				UMETA(Hidden),
 };
 
 UENUM(BlueprintType)
@@ -58,6 +61,17 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Equipment")
 		class UEquipmentComponent* EquipmentComponent;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Ability System")
+		class UMOBACooldownTrackerComponent* CooldownTracker;
+
+	// Receive one BP_AttributesChange per frame listing every changed attribute instead of one BP_*Change event per modifier
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability System")
+		bool bCoalesceAttributeNotifications = false;
+
+	// Regenerate health and mana through UMOBARegenerationSubsystem. The HealthRegen/ManaRegen passive abilities are not granted.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability System")
+		bool bUseRegenerationSubsystem = true;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Team")
 		ETeam MyTeam;
 
@@ -73,6 +87,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "BasicAttack")
 		int32 ComboIndex = 0;
 
+	// Keys this character's combat rolls. Assigned by the game mode on the server.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 CombatRandomId = 0;
+
+	// Number of attacks this character has rolled for so far
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 CombatRollIndex = 0;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "BasicAttack")
 		bool bUseOffHandWeapon = false;
 
@@ -88,6 +110,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BasicAttack")
 		FName ProjectileSpawnSocket;
 
+	// Basic attack projectiles parked in the projectile pool at BeginPlay so the first attacks don't spawn actors
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BasicAttack")
+		int32 BasicAttackProjectilePrewarmCount = 3;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting")
 		AMOBACharacter* MyEnemyTarget;
 
@@ -117,17 +143,65 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 		bool GetOffHandWeaponEquipped();
 
-	FTimerHandle CombatTimerHandle;	
+	// Slot, team and grid cell this character occupies in UMOBACharacterRegistrySubsystem. Owned by the registry.
+	int32 RegistryIndex = INDEX_NONE;
+	ETeam RegistryTeam = ETeam::BottomSide;
+	int32 SpatialCellIndex = INDEX_NONE;
+	int32 SpatialCellSlot = INDEX_NONE;
+
+	// Borrow an ability range sphere from this character's pool, sized to Radius and generating overlaps
+	USphereComponent* AcquireRangeSphere(float Radius);
+
+	// Return a sphere from AcquireRangeSphere. It stops colliding until it is acquired again.
+	void ReleaseRangeSphere(USphereComponent* RangeSphere);
+
+	// Launch a projectile on the server. Instead of replicating the actor, clients get a spawn event and fly their own copy.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Projectile")
+		AProjectile* LaunchProjectile(TSubclassOf<AProjectile> InProjectileClass, FTransform SpawnTransform, bool IsSingleTarget, ACharacter* CharacterTarget = NULL, FVector Direction = FVector(0,0,0), float InMaxDistance = 0.0f);
+
+	// Launch ProjectileClass from ProjectileSpawnSocket at Target through LaunchProjectile, reusing pooled projectiles
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "BasicAttack")
+		AProjectile* LaunchBasicAttackProjectile(ACharacter* Target);
+
+	UFUNCTION(NetMulticast, Unreliable)
+		void MulticastProjectileSpawned(const FMOBAProjectileSpawnEvent& SpawnEvent);
+
+	UFUNCTION(NetMulticast, Reliable)
+		void MulticastProjectileResolved(uint16 ProjectileId, ACharacter* InHitTarget, bool bHitTarget);
+
+	UFUNCTION()
+		void OnLaunchedProjectileResolved(AProjectile* Projectile, bool bHitTarget);
+	UFUNCTION()
+		void OnProxyProjectileResolved(AProjectile* Projectile, bool bHitTarget);
+
+	// Random stream for this character's next attack. Advances CombatRollIndex.
+	FMOBACombatRandom NextCombatRandom();
+
+	// World time of the last hostile hit dealt or taken. Combat ends UMOBACombatTimerSubsystem::CombatDuration after it.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		float LastHostileInteractionTime = 0.0f;
+
+	// Whether this character is waiting on the combat timer wheel. Owned by UMOBACombatTimerSubsystem.
+	bool bCombatTimerScheduled = false;
+
+	// Put this character in combat, or keep it there. Broadcasts CombatStatusChangeDelegate only when entering combat.
+	void RefreshCombat();
+
+	// Combat timer expired, leave combat
+	void CombatTimerCallback();
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void PossessedBy(AController* NewController) override;
 
 	// Event Handlers for receiving attribute set delegate broadcasts
 	UFUNCTION()
-		void InventoryChange(TArray<UItem*> AffectedSlots, TArray<int32> AffectedIndices);
+		void InventoryChange(TArray<FItemInstance> AffectedSlots, TArray<int32> AffectedIndices);
 	UFUNCTION()
 		void EquipmentChange(uint8 AffectedSlot, UEquipment* EquipmentObjRef);
+	UFUNCTION()
+		void AttributesChange(int32 ChangedAttributesMask);
 	UFUNCTION()
 		void HealthChange(FGameplayAttributeData health, FGameplayAttributeData maxhealth);
 	UFUNCTION()
@@ -179,9 +253,11 @@ public:
 
 	// Called by the above event handlers to expose to blueprints. Useful for updating UI.
 	UFUNCTION(BlueprintImplementableEvent)
-		void BP_InventoryChange(const TArray<UItem*>& AffectedSlots, const TArray<int32>& AffectedIndices);
+		void BP_InventoryChange(const TArray<FItemInstance>& AffectedSlots, const TArray<int32>& AffectedIndices);
 	UFUNCTION(BlueprintImplementableEvent)
 		void BP_EquipmentChange(ESlotType AffectedSlot, UEquipment* EquipmentObjRef);
+	UFUNCTION(BlueprintImplementableEvent)
+		void BP_AttributesChange(const TArray<EMOBAAttribute>& ChangedAttributes);
 	UFUNCTION(BlueprintImplementableEvent)
 		void BP_HealthChange(FGameplayAttributeData health, FGameplayAttributeData maxhealth);
 	UFUNCTION(BlueprintImplementableEvent)
@@ -234,6 +310,20 @@ public:
 	FCombatStatusChange CombatStatusChangeDelegate;
 
 protected:
-	void CombatTimerCallback();
+	// Idle range spheres created by AcquireRangeSphere, reused across ability activations
+	UPROPERTY()
+		TArray<USphereComponent*> RangeSpherePool;
+
+	// Take a projectile from the world's pool, or spawn one, owned by this character
+	AProjectile* AcquireProjectileActor(TSubclassOf<AProjectile> InProjectileClass, const FTransform& SpawnTransform);
+
+	// Acquire and release Count projectiles so the pool holds them before they are needed
+	void PrewarmProjectileActors(TSubclassOf<AProjectile> InProjectileClass, int32 Count);
+
+	// Id of the next projectile launched, sent with its spawn and resolve events
+	uint16 NextProjectileNetId = 0;
+
+	// Client copies of this character's projectiles still in flight, by id
+	TMap<uint16, TWeakObjectPtr<AProjectile>> ProxyProjectiles;
 };
 
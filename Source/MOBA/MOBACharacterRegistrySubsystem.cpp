@@ -0,0 +1,233 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBACharacterRegistrySubsystem.h"
+#include "MOBAAttributeSet.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/LevelBounds.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+
+void UMOBACharacterRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Teams.SetNum(static_cast<int32>(ETeam::MAX));
+}
+
+void UMOBACharacterRegistrySubsystem::RegisterCharacter(AMOBACharacter* Character)
+{
+	if (!Character || Character->RegistryIndex != INDEX_NONE) return;
+	if (!SpatialGrid.IsInitialized()) InitializeSpatialGrid();
+	AddToRoster(Character, Character->MyTeam);
+	SpatialGrid.Add(Character, Character->GetActorLocation(), Character->AttributeSet && Character->AttributeSet->Health.GetCurrentValue() > 0.0f);
+	NumRegistered++;
+}
+
+void UMOBACharacterRegistrySubsystem::UnregisterCharacter(AMOBACharacter* Character)
+{
+	if (!Character || Character->RegistryIndex == INDEX_NONE) return;
+	RemoveFromRoster(Character);
+	SpatialGrid.Remove(Character);
+	NumRegistered--;
+}
+
+void UMOBACharacterRegistrySubsystem::AddToRoster(AMOBACharacter* Character, ETeam Team)
+{
+	FMOBATeamRoster& Roster = Teams[static_cast<uint8>(Team)];
+	Character->RegistryTeam = Team;
+	Character->RegistryIndex = Roster.Characters.Add(Character);
+	Roster.Locations.Add(Character->GetActorLocation());
+	Roster.CapsuleRadii.Add(Character->GetCapsuleComponent() ? Character->GetCapsuleComponent()->GetScaledCapsuleRadius() : 0.0f);
+	Roster.Health.Add(Character->AttributeSet ? Character->AttributeSet->Health.GetCurrentValue() : 0.0f);
+	Roster.MaxHealth.Add(Character->AttributeSet ? Character->AttributeSet->MaxHealth.GetCurrentValue() : 0.0f);
+	Roster.Level.Add(Character->AttributeSet ? Character->AttributeSet->Level.GetCurrentValue() : 0.0f);
+}
+
+void UMOBACharacterRegistrySubsystem::RemoveFromRoster(AMOBACharacter* Character)
+{
+	FMOBATeamRoster& Roster = Teams[static_cast<uint8>(Character->RegistryTeam)];
+	const int32 Index = Character->RegistryIndex;
+	check(Roster.Characters.IsValidIndex(Index) && Roster.Characters[Index] == Character);
+	Roster.Characters.RemoveAtSwap(Index, 1, false);
+	Roster.Locations.RemoveAtSwap(Index, 1, false);
+	Roster.CapsuleRadii.RemoveAtSwap(Index, 1, false);
+	Roster.Health.RemoveAtSwap(Index, 1, false);
+	Roster.MaxHealth.RemoveAtSwap(Index, 1, false);
+	Roster.Level.RemoveAtSwap(Index, 1, false);
+	// The last character moved into the freed slot
+	if (Roster.Characters.IsValidIndex(Index))
+	{
+		Roster.Characters[Index]->RegistryIndex = Index;
+	}
+	Character->RegistryIndex = INDEX_NONE;
+}
+
+void UMOBACharacterRegistrySubsystem::Tick(float DeltaTime)
+{
+	for (uint8 TeamIndex = 0; TeamIndex < Teams.Num(); TeamIndex++)
+	{
+		FMOBATeamRoster& Roster = Teams[TeamIndex];
+		for (int32 Index = 0; Index < Roster.Num(); Index++)
+		{
+			AMOBACharacter* Character = Roster.Characters[Index];
+			if (Character->MyTeam != Character->RegistryTeam)
+			{
+				// Changed sides, this slot now holds another character
+				RemoveFromRoster(Character);
+				AddToRoster(Character, Character->MyTeam);
+				Index--;
+				continue;
+			}
+			Roster.Locations[Index] = Character->GetActorLocation();
+			if (const UMOBAAttributeSet* AttributeSet = Character->AttributeSet)
+			{
+				Roster.Health[Index] = AttributeSet->Health.GetCurrentValue();
+				Roster.MaxHealth[Index] = AttributeSet->MaxHealth.GetCurrentValue();
+				Roster.Level[Index] = AttributeSet->Level.GetCurrentValue();
+			}
+			SpatialGrid.Update(Character, Roster.Locations[Index], Roster.Health[Index] > 0.0f);
+		}
+	}
+}
+
+bool UMOBACharacterRegistrySubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && NumRegistered > 0;
+}
+
+TStatId UMOBACharacterRegistrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMOBACharacterRegistrySubsystem, STATGROUP_Tickables);
+}
+
+bool UMOBACharacterRegistrySubsystem::IsInRange(const FVector& Location, const AMOBACharacter* Target, float Range) const
+{
+	if (!Target) return false;
+	if (Target->RegistryIndex != INDEX_NONE)
+	{
+		const FMOBATeamRoster& Roster = GetTeamRoster(Target->RegistryTeam);
+		return IsWithinRange2D(Location, Target->GetActorLocation(), Range, Roster.CapsuleRadii[Target->RegistryIndex]);
+	}
+	const float TargetRadius = Target->GetCapsuleComponent() ? Target->GetCapsuleComponent()->GetScaledCapsuleRadius() : 0.0f;
+	return IsWithinRange2D(Location, Target->GetActorLocation(), Range, TargetRadius);
+}
+
+AMOBACharacter* UMOBACharacterRegistrySubsystem::FindNearestHostile(ETeam Team, const FVector& Location, float Radius) const
+{
+	return SpatialGrid.FindNearestHostile(Team, Location, Radius);
+}
+
+void UMOBACharacterRegistrySubsystem::GetAlliesInRadius(ETeam Team, const FVector& Location, float Radius, TArray<AMOBACharacter*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	TArray<const FMOBASpatialGrid::FEntry*> Entries;
+	SpatialGrid.GetEntriesInRadius(Location, Radius, Entries);
+	for (const FMOBASpatialGrid::FEntry* Entry : Entries)
+	{
+		if (Entry->Team == Team) OutCharacters.Add(Entry->Character);
+	}
+}
+
+void UMOBACharacterRegistrySubsystem::GetHostilesInRadius(ETeam Team, const FVector& Location, float Radius, TArray<AMOBACharacter*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	TArray<const FMOBASpatialGrid::FEntry*> Entries;
+	SpatialGrid.GetEntriesInRadius(Location, Radius, Entries);
+	for (const FMOBASpatialGrid::FEntry* Entry : Entries)
+	{
+		if (IsHostileTeam(Team, Entry->Team)) OutCharacters.Add(Entry->Character);
+	}
+}
+
+void UMOBACharacterRegistrySubsystem::SweepSkillshot(ETeam Team, const FVector& Start, const FVector& End, float Radius, TArray<FMOBASpatialGrid::FSweepHit>& OutHits) const
+{
+	SpatialGrid.SweepCircle(Team, FVector2D(Start), FVector2D(End), Radius, OutHits);
+}
+
+void UMOBACharacterRegistrySubsystem::GetCharactersInRadius(const FVector& Location, float Radius, TArray<AMOBACharacter*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	TArray<const FMOBASpatialGrid::FEntry*> Entries;
+	SpatialGrid.GetEntriesInRadius(Location, Radius, Entries);
+	for (const FMOBASpatialGrid::FEntry* Entry : Entries)
+	{
+		OutCharacters.Add(Entry->Character);
+	}
+}
+
+AMOBACharacter* UMOBACharacterRegistrySubsystem::FindCharacterOnRay(const FVector& Origin, const FVector& Direction, const AMOBACharacter* IgnoreCharacter) const
+{
+	AMOBACharacter* NearestCharacter = nullptr;
+	float NearestTime = MAX_flt;
+	const FVector2D Direction2D(Direction);
+	const float Direction2DSquared = Direction2D.SizeSquared();
+	for (const FMOBATeamRoster& Roster : Teams)
+	{
+		for (int32 Index = 0; Index < Roster.Num(); Index++)
+		{
+			if (Roster.Health[Index] <= 0.0f || Roster.Characters[Index] == IgnoreCharacter) continue;
+			const FVector& Center = Roster.Locations[Index];
+			const float Radius = Roster.CapsuleRadii[Index];
+			const UCapsuleComponent* Capsule = Roster.Characters[Index]->GetCapsuleComponent();
+			const float HalfHeight = Capsule ? Capsule->GetScaledCapsuleHalfHeight() : Radius;
+			float HitTime = MAX_flt;
+			// Looking down through the top
+			if (Direction.Z < 0.0f)
+			{
+				const float TopTime = (Center.Z + HalfHeight - Origin.Z) / Direction.Z;
+				if (TopTime >= 0.0f && FVector::DistSquared2D(Origin + Direction * TopTime, Center) <= FMath::Square(Radius))
+				{
+					HitTime = TopTime;
+				}
+			}
+			// Entering through the side
+			if (Direction2DSquared > KINDA_SMALL_NUMBER)
+			{
+				const FVector2D ToCenter(Center.X - Origin.X, Center.Y - Origin.Y);
+				const float Projection = ToCenter | Direction2D;
+				const float Discriminant = FMath::Square(Projection) - Direction2DSquared * (ToCenter.SizeSquared() - FMath::Square(Radius));
+				if (Discriminant >= 0.0f)
+				{
+					const float SideTime = (Projection - FMath::Sqrt(Discriminant)) / Direction2DSquared;
+					if (SideTime >= 0.0f && SideTime < HitTime && FMath::Abs(Origin.Z + Direction.Z * SideTime - Center.Z) <= HalfHeight)
+					{
+						HitTime = SideTime;
+					}
+				}
+			}
+			if (HitTime < NearestTime)
+			{
+				NearestTime = HitTime;
+				NearestCharacter = Roster.Characters[Index];
+			}
+		}
+	}
+	return NearestCharacter;
+}
+
+void UMOBACharacterRegistrySubsystem::InitializeSpatialGrid()
+{
+	// Characters only walk on the navmesh, so its bounds volumes are the play area
+	FBox PlayBounds(ForceInit);
+	if (UWorld* World = GetWorld())
+	{
+		for (TActorIterator<ANavMeshBoundsVolume> It(World); It; ++It)
+		{
+			PlayBounds += It->GetComponentsBoundingBox(true);
+		}
+		if (!PlayBounds.IsValid && World->PersistentLevel)
+		{
+			PlayBounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+		}
+	}
+	if (!PlayBounds.IsValid)
+	{
+		PlayBounds = FBox(FVector(-20000.0f), FVector(20000.0f));
+	}
+	// Cap the size around the center. Characters outside the grid fall in its edge cells.
+	FBox2D GridBounds(FVector2D(PlayBounds.Min), FVector2D(PlayBounds.Max));
+	const FVector2D Center = GridBounds.GetCenter();
+	const FVector2D HalfExtent = GridBounds.GetExtent().ClampAxes(0.0f, MaxSpatialGridExtent / 2);
+	SpatialGrid.Initialize(FBox2D(Center - HalfExtent, Center + HalfExtent), SpatialGridCellSize);
+}
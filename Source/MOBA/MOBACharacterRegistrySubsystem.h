@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "MOBACharacter.h"
+#include "MOBASpatialGrid.h"
+#include "MOBACharacterRegistrySubsystem.generated.h"
+
+// Live characters of one team. Every array shares indices, values are refreshed once per frame.
+USTRUCT()
+struct FMOBATeamRoster
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TArray<AMOBACharacter*> Characters;
+
+	TArray<FVector> Locations;
+	TArray<float> CapsuleRadii;
+	TArray<float> Health;
+	TArray<float> MaxHealth;
+	TArray<float> Level;
+
+	int32 Num() const { return Characters.Num(); }
+};
+
+/**
+ * Index of every live AMOBACharacter in the world, split by team. Characters join in BeginPlay and leave in EndPlay.
+ * Gameplay queries (nearest enemy, allies in radius, experience sharing) read these arrays instead of the physics scene.
+ * Radius queries go through a uniform grid over the map that is updated in the same pass.
+ */
+UCLASS()
+class MOBA_API UMOBACharacterRegistrySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	void RegisterCharacter(AMOBACharacter* Character);
+	void UnregisterCharacter(AMOBACharacter* Character);
+
+	// Same rule as AMOBACharacter::IsHostile, by team only
+	static FORCEINLINE bool IsHostileTeam(ETeam MyTeam, ETeam OtherTeam) { return MyTeam != OtherTeam && OtherTeam != ETeam::NeutralFriendly; }
+
+	// Whether a target of TargetRadius at To is within Range of From, by 2D distance to the target's edge
+	static FORCEINLINE bool IsWithinRange2D(const FVector& From, const FVector& To, float Range, float TargetRadius)
+	{
+		return FVector::DistSquared2D(From, To) <= FMath::Square(Range + TargetRadius);
+	}
+
+	// Whether Target's capsule is within Range of Location, by 2D distance
+	bool IsInRange(const FVector& Location, const AMOBACharacter* Target, float Range) const;
+
+	const FMOBATeamRoster& GetTeamRoster(ETeam Team) const { return Teams[static_cast<uint8>(Team)]; }
+
+	// Closest living character hostile to Team within Radius of Location, by 2D distance. Null if there is none.
+	AMOBACharacter* FindNearestHostile(ETeam Team, const FVector& Location, float Radius) const;
+
+	// Living characters of Team within Radius of Location, by 2D distance
+	void GetAlliesInRadius(ETeam Team, const FVector& Location, float Radius, TArray<AMOBACharacter*>& OutCharacters) const;
+
+	// Skillshot query: living characters hostile to Team that a circle of Radius touches moving from Start to End, ordered by time of impact
+	void SweepSkillshot(ETeam Team, const FVector& Start, const FVector& End, float Radius, TArray<FMOBASpatialGrid::FSweepHit>& OutHits) const;
+
+	// Every living character within Radius of Location, by 2D distance
+	void GetCharactersInRadius(const FVector& Location, float Radius, TArray<AMOBACharacter*>& OutCharacters) const;
+
+	// Cursor pick: first living character other than IgnoreCharacter whose capsule, taken as an upright cylinder, the ray from Origin along Direction enters
+	AMOBACharacter* FindCharacterOnRay(const FVector& Origin, const FVector& Direction, const AMOBACharacter* IgnoreCharacter = nullptr) const;
+
+	// Living characters hostile to Team within Radius of Location, by 2D distance
+	void GetHostilesInRadius(ETeam Team, const FVector& Location, float Radius, TArray<AMOBACharacter*>& OutCharacters) const;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+	void AddToRoster(AMOBACharacter* Character, ETeam Team);
+	void RemoveFromRoster(AMOBACharacter* Character);
+	// Size the grid to the navmesh bounds volumes, or the persistent level's bounds if there are none
+	void InitializeSpatialGrid();
+
+	// One roster per ETeam value
+	UPROPERTY()
+		TArray<FMOBATeamRoster> Teams;
+
+	FMOBASpatialGrid SpatialGrid;
+
+	// Edge length of one grid cell in world units
+	float SpatialGridCellSize = 1000.0f;
+
+	// Largest grid edge in world units. Stray geometry like skyboxes can make level bounds far larger than the play area.
+	float MaxSpatialGridExtent = 60000.0f;
+
+	int32 NumRegistered = 0;
+};
@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBACombatFormulas.h"
+
+void FMOBACombatFormulas::TimeToKillBatch(const float* HitDamage, float AttackInterval, const float* MaxHealth, int32 NumDefenders, float* OutTimeToKill)
+{
+	// Hits needed per defender, four defenders per iteration
+	int32 Index = 0;
+	for (; Index + 4 <= NumDefenders; Index += 4)
+	{
+		VectorStore(VectorDivide(VectorLoad(MaxHealth + Index), VectorLoad(HitDamage + Index)), OutTimeToKill + Index);
+	}
+	for (; Index < NumDefenders; Index++)
+	{
+		OutTimeToKill[Index] = MaxHealth[Index] / HitDamage[Index];
+	}
+
+	// Whole hits, then time between the first and the last one
+	for (Index = 0; Index < NumDefenders; Index++)
+	{
+		const float Hits = OutTimeToKill[Index];
+		OutTimeToKill[Index] = (Hits > 0.0f && FMath::IsFinite(Hits)) ? (FMath::CeilToFloat(Hits) - 1) * AttackInterval : MAX_flt;
+	}
+}
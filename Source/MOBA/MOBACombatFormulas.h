@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Combat math with no UObject or gameplay ability dependencies. Shared by the gameplay effect calculations
+ * and the headless combat simulator (UMOBACombatSimCommandlet) so balance runs use exactly the game's formulas.
+ */
+struct MOBA_API FMOBACombatFormulas
+{
+	// Off hand attacks are 15% faster when dual wielding
+	static constexpr float DualWieldAttackSpeedMultiplier = 1.15f;
+
+	// Resistance stat (Armor, EnvironmentalResistance) to a damage reduction fraction. Negative resistance increases damage taken.
+	static FORCEINLINE float DamageReduction(float ResistanceStat)
+	{
+		if (ResistanceStat >= 0)
+		{
+			return 1 - (100 / (100 + ResistanceStat));
+		}
+		return 1 - (2 - (100 / (100 - ResistanceStat)));
+	}
+
+	// Damage left after the damage type's reduction and flat damage reduction. True damage passes 0 as its type reduction.
+	static FORCEINLINE float MitigateDamage(float RawDamage, float TypeDamageReduction, float FlatDamageReduction)
+	{
+		return RawDamage * (1 - TypeDamageReduction) * (1 - FlatDamageReduction);
+	}
+
+	// Seconds between basic attacks
+	static FORCEINLINE float AttackInterval(float AttackSpeed, float BonusAttackSpeed, float Multiplier = 1.0f)
+	{
+		return 1 / (AttackSpeed * (1 + BonusAttackSpeed) * Multiplier);
+	}
+
+	// Average damage multiplier from critical strikes
+	static FORCEINLINE float ExpectedCriticalMultiplier(float CriticalChance, float CriticalDamage)
+	{
+		return 1 + FMath::Clamp(CriticalChance, 0.0f, 1.0f) * (CriticalDamage - 1);
+	}
+
+	// Time for one attacker to kill each defender with basic attacks, the first hit landing at time 0.
+	// HitDamage is the mitigated damage each defender takes per hit. Evaluated four defenders at a time with vector instructions.
+	static void TimeToKillBatch(const float* HitDamage, float AttackInterval, const float* MaxHealth, int32 NumDefenders, float* OutTimeToKill);
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Independent rolls drawn for the same attack
+enum class EMOBACombatRoll : uint32
+{
+	MainHandDamage,
+	OffHandDamage,
+	Critical,
+};
+
+/**
+ * Counter-based random numbers for combat rolls. Every roll is a pure function of (match seed, source, attack index, roll),
+ * so any hit can be recomputed later, in any order, without shared generator state. No allocation, a few multiplies per roll.
+ */
+struct FMOBACombatRandom
+{
+	uint64 MatchSeed = 0;
+	uint32 SourceId = 0;
+	uint32 AttackIndex = 0;
+
+	FMOBACombatRandom() {}
+	FMOBACombatRandom(uint64 InMatchSeed, uint32 InSourceId, uint32 InAttackIndex)
+		: MatchSeed(InMatchSeed)
+		, SourceId(InSourceId)
+		, AttackIndex(InAttackIndex)
+	{}
+
+	// Uniform value in [0, 1)
+	FORCEINLINE float GetFraction(EMOBACombatRoll Roll) const
+	{
+		const uint64 Key = Mix(MatchSeed ^ (static_cast<uint64>(SourceId) * 0x9E3779B97F4A7C15ull));
+		const uint64 Counter = (static_cast<uint64>(AttackIndex) << 32) | static_cast<uint32>(Roll);
+		// Top 24 bits fill a float mantissa exactly
+		return static_cast<float>(Mix(Key ^ Counter) >> 40) * (1.0f / 16777216.0f);
+	}
+
+	// Uniform value in [Min, Max)
+	FORCEINLINE float GetRange(EMOBACombatRoll Roll, float Min, float Max) const
+	{
+		return Min + (Max - Min) * GetFraction(Roll);
+	}
+
+private:
+	// SplitMix64 finalizer
+	static FORCEINLINE uint64 Mix(uint64 Value)
+	{
+		Value += 0x9E3779B97F4A7C15ull;
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+};
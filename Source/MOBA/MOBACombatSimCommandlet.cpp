@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBACombatSimCommandlet.h"
+#include "MOBACombatFormulas.h"
+#include "CalculateDamage.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMOBACombatSim, Log, All);
+
+namespace
+{
+	// One CSV file as a header row plus value rows
+	struct FCombatSimTable
+	{
+		TArray<FString> Columns;
+		TArray<TArray<FString>> Rows;
+
+		bool Load(const FString& Path)
+		{
+			TArray<FString> Lines;
+			if (!FFileHelper::LoadFileToStringArray(Lines, *Path) || Lines.Num() == 0)
+			{
+				UE_LOG(LogMOBACombatSim, Error, TEXT("Could not read %s"), *Path);
+				return false;
+			}
+			Lines[0].ParseIntoArray(Columns, TEXT(","), false);
+			for (int32 LineIndex = 1; LineIndex < Lines.Num(); LineIndex++)
+			{
+				if (Lines[LineIndex].TrimStartAndEnd().IsEmpty()) continue;
+				Lines[LineIndex].ParseIntoArray(Rows.AddDefaulted_GetRef(), TEXT(","), false);
+			}
+			return true;
+		}
+
+		FString GetString(int32 Row, const TCHAR* Column) const
+		{
+			const int32 ColumnIndex = Columns.IndexOfByPredicate([Column](const FString& Name) { return Name.TrimStartAndEnd() == Column; });
+			return Rows[Row].IsValidIndex(ColumnIndex) ? Rows[Row][ColumnIndex].TrimStartAndEnd() : FString();
+		}
+
+		float GetFloat(int32 Row, const TCHAR* Column, float Default = 0.0f) const
+		{
+			const FString Value = GetString(Row, Column);
+			return Value.IsEmpty() ? Default : FCString::Atof(*Value);
+		}
+	};
+
+	// DamageType column: Physical (default), Environmental or True
+	EMOBADamageType ParseDamageType(const FString& Value)
+	{
+		if (Value == TEXT("Environmental")) return EMOBADamageType::Environmental;
+		if (Value == TEXT("True") || Value == TEXT("TrueDamage")) return EMOBADamageType::TrueDamage;
+		return EMOBADamageType::Physical;
+	}
+}
+
+UMOBACombatSimCommandlet::UMOBACombatSimCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMOBACombatSimCommandlet::Main(const FString& Params)
+{
+	FString AttackersPath, DefendersPath, OutputPath;
+	if (!FParse::Value(*Params, TEXT("Attackers="), AttackersPath) || !FParse::Value(*Params, TEXT("Defenders="), DefendersPath) || !FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		UE_LOG(LogMOBACombatSim, Error, TEXT("Usage: -run=MOBACombatSim -Attackers=<csv> -Defenders=<csv> -Output=<csv>"));
+		return 1;
+	}
+
+	FCombatSimTable Attackers, Defenders;
+	if (!Attackers.Load(AttackersPath) || !Defenders.Load(DefendersPath)) return 1;
+
+	// Defenders as the same target batch the abilities use, so each attacker runs one pass over all of them
+	const int32 NumDefenders = Defenders.Rows.Num();
+	FMOBADamageTargetBatch DefenderBatch;
+	TArray<float> MaxHealth;
+	DefenderBatch.Reserve(NumDefenders);
+	MaxHealth.SetNumUninitialized(NumDefenders);
+	for (int32 Defender = 0; Defender < NumDefenders; Defender++)
+	{
+		DefenderBatch.PhysicalDamageReduction.Add(FMOBACombatFormulas::DamageReduction(Defenders.GetFloat(Defender, TEXT("Armor"))));
+		DefenderBatch.EnvironmentalDamageReduction.Add(FMOBACombatFormulas::DamageReduction(Defenders.GetFloat(Defender, TEXT("EnvironmentalResistance"))));
+		DefenderBatch.FlatDamageReduction.Add(Defenders.GetFloat(Defender, TEXT("FlatDamageReduction")));
+		DefenderBatch.HealingModifier.Add(1.0f);
+		DefenderBatch.HealthRegen.Add(0.0f);
+		MaxHealth[Defender] = Defenders.GetFloat(Defender, TEXT("MaxHealth"));
+	}
+
+	// Row per attacker, column per defender
+	const int32 NumAttackers = Attackers.Rows.Num();
+	TArray<float> TimeToKill;
+	TimeToKill.SetNumUninitialized(NumAttackers * NumDefenders);
+	ParallelFor(NumAttackers, [&](int32 Attacker)
+	{
+		// Expected main hand basic attack as a damage recipe: average weapon roll, averaged critical strikes
+		FMOBADamageRecipe Recipe;
+		Recipe.Kind = EMOBARecipeKind::Damage;
+		Recipe.DamageType = ParseDamageType(Attackers.GetString(Attacker, TEXT("DamageType")));
+		Recipe.WeaponDamageType = EWeaponDamageType::MainHand;
+		Recipe.BaseValue = Attackers.GetFloat(Attacker, TEXT("BaseValue"));
+		Recipe.AttackPowerRatio = Attackers.GetFloat(Attacker, TEXT("AttackPowerRatio"), 1.0f);
+		Recipe.SpellPowerRatio = Attackers.GetFloat(Attacker, TEXT("SpellPowerRatio"));
+		FMOBADamageSourceSnapshot SourceSnapshot;
+		SourceSnapshot.AttackPower = Attackers.GetFloat(Attacker, TEXT("AttackPower"));
+		SourceSnapshot.SpellPower = Attackers.GetFloat(Attacker, TEXT("SpellPower"));
+		SourceSnapshot.WeaponDamage = (Attackers.GetFloat(Attacker, TEXT("MainHandMinDamage")) + Attackers.GetFloat(Attacker, TEXT("MainHandMaxDamage"))) / 2;
+		SourceSnapshot.CriticalMultiplier = FMOBACombatFormulas::ExpectedCriticalMultiplier(Attackers.GetFloat(Attacker, TEXT("CriticalChance")), Attackers.GetFloat(Attacker, TEXT("CriticalDamage"), 1.0f));
+
+		// Same per target evaluation as the game, health deltas are negative for damage
+		TArray<float> HitDamage;
+		UCalculateDamage::CalculateHealthDeltas(Recipe, SourceSnapshot, DefenderBatch, HitDamage);
+		for (float& Damage : HitDamage) Damage = -Damage;
+		const float AttackInterval = FMOBACombatFormulas::AttackInterval(Attackers.GetFloat(Attacker, TEXT("MainHandAttackSpeed"), 1.0f), Attackers.GetFloat(Attacker, TEXT("BonusAttackSpeed")));
+		FMOBACombatFormulas::TimeToKillBatch(HitDamage.GetData(), AttackInterval, MaxHealth.GetData(), NumDefenders, TimeToKill.GetData() + Attacker * NumDefenders);
+	});
+
+	TArray<FString> Lines;
+	Lines.Reserve(NumAttackers + 1);
+	FString& Header = Lines.Emplace_GetRef(TEXT("Attacker"));
+	for (int32 Defender = 0; Defender < NumDefenders; Defender++)
+	{
+		Header += TEXT(",") + Defenders.GetString(Defender, TEXT("Name"));
+	}
+	for (int32 Attacker = 0; Attacker < NumAttackers; Attacker++)
+	{
+		FString& Line = Lines.Emplace_GetRef(Attackers.GetString(Attacker, TEXT("Name")));
+		for (int32 Defender = 0; Defender < NumDefenders; Defender++)
+		{
+			const float Seconds = TimeToKill[Attacker * NumDefenders + Defender];
+			Line += Seconds == MAX_flt ? FString(TEXT(",inf")) : FString::Printf(TEXT(",%.3f"), Seconds);
+		}
+	}
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputPath))
+	{
+		UE_LOG(LogMOBACombatSim, Error, TEXT("Could not write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogMOBACombatSim, Display, TEXT("Wrote %d x %d time to kill grid to %s"), NumAttackers, NumDefenders, *OutputPath);
+	return 0;
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MOBACombatSimCommandlet.generated.h"
+
+/**
+ * Headless balance run. Reads attacker and defender stat lines from CSV and writes the basic attack time to kill
+ * for every pairing. Damage goes through UCalculateDamage::CalculateHealthDeltas, the same path the abilities use.
+ * Usage: UE4Editor-Cmd MOBA -run=MOBACombatSim -Attackers=A.csv -Defenders=D.csv -Output=TTK.csv
+ */
+UCLASS()
+class MOBA_API UMOBACombatSimCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMOBACombatSimCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
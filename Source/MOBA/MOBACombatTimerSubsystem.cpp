@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBACombatTimerSubsystem.h"
+#include "MOBACharacter.h"
+#include "Engine/World.h"
+
+void UMOBACombatTimerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Slots.SetNum(FMath::CeilToInt(CombatDuration / SlotSeconds) + 2);
+}
+
+void UMOBACombatTimerSubsystem::NotifyHostileInteraction(AMOBACharacter* Character)
+{
+	const UWorld* World = GetWorld();
+	if (!Character || !World) return;
+	Character->LastHostileInteractionTime = World->GetTimeSeconds();
+	if (!Character->bCombatTimerScheduled)
+	{
+		if (NumScheduled == 0)
+		{
+			// Wheel was idle, start turning from the current time
+			NextSlotToProcess = GetAbsoluteSlot(Character->LastHostileInteractionTime);
+		}
+		Schedule(Character, Character->LastHostileInteractionTime + CombatDuration);
+	}
+}
+
+void UMOBACombatTimerSubsystem::Schedule(AMOBACharacter* Character, float ExpiryTime)
+{
+	const int64 AbsoluteSlot = FMath::Max(GetAbsoluteSlot(ExpiryTime), NextSlotToProcess);
+	Slots[AbsoluteSlot % Slots.Num()].Add(Character);
+	Character->bCombatTimerScheduled = true;
+	NumScheduled++;
+}
+
+void UMOBACombatTimerSubsystem::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	const int64 CurrentSlot = GetAbsoluteSlot(Now);
+	TArray<TWeakObjectPtr<AMOBACharacter>> DueCharacters;
+	for (; NextSlotToProcess < CurrentSlot && NumScheduled > 0; NextSlotToProcess++)
+	{
+		TArray<TWeakObjectPtr<AMOBACharacter>>& Slot = Slots[NextSlotToProcess % Slots.Num()];
+		if (Slot.Num() == 0) continue;
+		DueCharacters = MoveTemp(Slot);
+		Slot.Reset();
+		NumScheduled -= DueCharacters.Num();
+		for (const TWeakObjectPtr<AMOBACharacter>& WeakCharacter : DueCharacters)
+		{
+			AMOBACharacter* Character = WeakCharacter.Get();
+			if (!Character) continue;
+			Character->bCombatTimerScheduled = false;
+			const float ExpiryTime = Character->LastHostileInteractionTime + CombatDuration;
+			if (ExpiryTime <= Now)
+			{
+				Character->CombatTimerCallback();
+			}
+			else
+			{
+				// Hit again since it was scheduled, move it to its new expiry
+				Schedule(Character, ExpiryTime);
+			}
+		}
+	}
+	if (NumScheduled == 0) NextSlotToProcess = CurrentSlot;
+}
+
+bool UMOBACombatTimerSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && NumScheduled > 0;
+}
+
+TStatId UMOBACombatTimerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMOBACombatTimerSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "MOBACombatTimerSubsystem.generated.h"
+
+class AMOBACharacter;
+
+/**
+ * Drops characters out of combat CombatDuration seconds after their last hostile interaction.
+ * A hostile hit only writes the character's timestamp. Characters wait in a timer wheel of fixed size slots and are
+ * checked once when their slot comes up: expired ones leave combat, refreshed ones move to the slot of their new expiry.
+ */
+UCLASS()
+class MOBA_API UMOBACombatTimerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Record a hostile interaction for Character now, scheduling it on the wheel if it isn't already
+	void NotifyHostileInteraction(AMOBACharacter* Character);
+
+	// Seconds without hostile interaction before a character leaves combat
+	static constexpr float CombatDuration = 5.0f;
+
+	// Width of one wheel slot. Characters leave combat at most this late.
+	static constexpr float SlotSeconds = 0.1f;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+	void Schedule(AMOBACharacter* Character, float ExpiryTime);
+
+	// Slot index since world start for a time. Slots are processed once the world time passes their end.
+	static FORCEINLINE int64 GetAbsoluteSlot(float Time) { return FMath::FloorToInt(Time / SlotSeconds); }
+
+	// One list per slot, covering more than CombatDuration so a slot never holds two revolutions
+	TArray<TArray<TWeakObjectPtr<AMOBACharacter>>> Slots;
+
+	int64 NextSlotToProcess = 0;
+	int32 NumScheduled = 0;
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBACooldownTrackerComponent.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/World.h"
+
+UMOBACooldownTrackerComponent::UMOBACooldownTrackerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMOBACooldownTrackerComponent::Initialize(UAbilitySystemComponent* InAbilitySystemComponent)
+{
+	if (!InAbilitySystemComponent || AbilitySystemComponent) return;
+	AbilitySystemComponent = InAbilitySystemComponent;
+	BasicAttackCooldownTag = FGameplayTag::RequestGameplayTag(FName("Abilities.Basic.BasicAttack.Cooldown"));
+	// Any count change, so a cooldown reapplied while one is still running refreshes the expiry
+	CooldownTagChangedHandle = AbilitySystemComponent->RegisterGameplayTagEvent(BasicAttackCooldownTag, EGameplayTagEventType::AnyCountChange)
+		.AddUObject(this, &UMOBACooldownTrackerComponent::OnCooldownTagChanged);
+}
+
+void UMOBACooldownTrackerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AbilitySystemComponent && CooldownTagChangedHandle.IsValid())
+	{
+		AbilitySystemComponent->RegisterGameplayTagEvent(BasicAttackCooldownTag, EGameplayTagEventType::AnyCountChange).Remove(CooldownTagChangedHandle);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+float UMOBACooldownTrackerComponent::GetBasicAttackCooldownRemaining()
+{
+	CooldownQueryCount++;
+	if (BasicAttackCooldownEndTime <= 0.0f) return 0.0f;
+	const UWorld* World = GetWorld();
+	return World ? FMath::Max(BasicAttackCooldownEndTime - World->GetTimeSeconds(), 0.0f) : 0.0f;
+}
+
+void UMOBACooldownTrackerComponent::OnCooldownTagChanged(const FGameplayTag CooldownTag, int32 NewCount)
+{
+	CooldownEventCount++;
+	if (NewCount > 0)
+	{
+		// Only scan the active effects when a cooldown starts or changes
+		const FGameplayEffectQuery Query = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(FGameplayTagContainer(BasicAttackCooldownTag));
+		float Remaining = 0.0f;
+		for (float TimeRemaining : AbilitySystemComponent->GetActiveEffectsTimeRemaining(Query))
+		{
+			Remaining = FMath::Max(Remaining, TimeRemaining);
+		}
+		const UWorld* World = GetWorld();
+		BasicAttackCooldownEndTime = (World && Remaining > 0.0f) ? World->GetTimeSeconds() + Remaining : 0.0f;
+	}
+	else
+	{
+		BasicAttackCooldownEndTime = 0.0f;
+		OnBasicAttackCooldownEnd.Broadcast();
+	}
+}
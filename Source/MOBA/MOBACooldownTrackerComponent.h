@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "MOBACooldownTrackerComponent.generated.h"
+
+class UAbilitySystemComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FBasicAttackCooldownEnd);
+
+/**
+ * Tracks when the basic attack cooldown expires. Listens to the cooldown tag's count changes on the ability system
+ * component and stores the expiry time, so the remaining cooldown is a subtraction instead of an active effect scan.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class MOBA_API UMOBACooldownTrackerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMOBACooldownTrackerComponent();
+
+	// Subscribe to the cooldown tag. Called once the owner's ability system component is set up.
+	void Initialize(UAbilitySystemComponent* InAbilitySystemComponent);
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Seconds until the basic attack cooldown ends, 0 when it is ready
+	UFUNCTION(BlueprintCallable, Category = "Abilities")
+		float GetBasicAttackCooldownRemaining();
+
+	// Broadcast when the last basic attack cooldown effect is removed
+	UPROPERTY(BlueprintAssignable, Category = "Abilities")
+		FBasicAttackCooldownEnd OnBasicAttackCooldownEnd;
+
+	// Number of GetBasicAttackCooldownRemaining calls served
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Abilities|Stats")
+		int32 CooldownQueryCount = 0;
+
+	// Number of cooldown tag changes handled, each one costs a single active effect scan
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Abilities|Stats")
+		int32 CooldownEventCount = 0;
+
+protected:
+	void OnCooldownTagChanged(const FGameplayTag CooldownTag, int32 NewCount);
+
+	UPROPERTY()
+		UAbilitySystemComponent* AbilitySystemComponent;
+
+	FGameplayTag BasicAttackCooldownTag;
+	FDelegateHandle CooldownTagChangedHandle;
+
+	// World time the current cooldown ends, 0 when no cooldown is active
+	float BasicAttackCooldownEndTime = 0.0f;
+};
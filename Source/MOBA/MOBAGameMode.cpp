@@ -4,9 +4,26 @@
 #include "MOBAPlayerController.h"
 #include "MOBACharacter.h"
 #include "UObject/ConstructorHelpers.h"
+#include "Kismet/GameplayStatics.h"
 
 AMOBAGameMode::AMOBAGameMode()
 {
 	// use our custom PlayerController class
 	PlayerControllerClass = AMOBAPlayerController::StaticClass();
-}
\ No newline at end of file
+}
+
+void AMOBAGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+	if (UGameplayStatics::HasOption(Options, TEXT("Seed")))
+	{
+		MatchSeed = FCString::Atoi64(*UGameplayStatics::ParseOption(Options, TEXT("Seed")));
+	}
+	else
+	{
+		// Full 64 bits, FMath::Rand only gives 15 on some platforms
+		const FGuid Guid = FGuid::NewGuid();
+		MatchSeed = static_cast<int64>((static_cast<uint64>(Guid.A) << 32) | Guid.B);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Combat match seed %lld"), MatchSeed);
+}
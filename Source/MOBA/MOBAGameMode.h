@@ -13,6 +13,18 @@ class AMOBAGameMode : public AGameModeBase
 
 public:
 	AMOBAGameMode();
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
+	// Seed for every combat roll this match. Taken from the "Seed" URL option when present so matches can be reproduced.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int64 MatchSeed = 0;
+
+	// Hand out the next id used to key a character's combat rolls
+	int32 AllocateCombatRandomId() { return NextCombatRandomId++; }
+
+protected:
+	int32 NextCombatRandomId = 1;
 };
 
 
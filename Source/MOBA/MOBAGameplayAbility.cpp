@@ -2,20 +2,170 @@
 
 
 #include "MOBAGameplayAbility.h"
+#include "MOBAAttributeSet.h"
+#include "CalculateDamage.h"
+#include "CalculateHealing.h"
+#include "HealthModifierEffect.h"
+#include "MOBACharacterRegistrySubsystem.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	// Compiled recipes keyed by ability data class. Only touched from the game thread.
+	// TObjectKey won't match a new class allocated at a collected class's address.
+	TMap<TObjectKey<UClass>, FMOBADamageRecipe> DamageRecipeCache;
+
+#if WITH_EDITOR
+	// Blueprint recompiles reinstance ability data classes, drop every recipe when that happens
+	void RegisterDamageRecipeCacheFlush()
+	{
+		static bool bRegistered = false;
+		if (bRegistered) return;
+		bRegistered = true;
+		FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&) { DamageRecipeCache.Reset(); });
+	}
+#endif
+
+	FMOBADamageRecipe CompileDamageRecipe(const UClass* AbilityDataClass)
+	{
+		FMOBADamageRecipe Recipe;
+		const UMOBAAbilityData* AbilityData = Cast<UMOBAAbilityData>(AbilityDataClass->GetDefaultObject());
+		if (!AbilityData) return Recipe;
+		Recipe.DamageType = AbilityData->DamageType;
+		Recipe.WeaponDamageType = AbilityData->WeaponDamageType;
+		Recipe.BaseValue = AbilityData->BaseValue;
+		Recipe.AttackPowerRatio = AbilityData->AttackPowerRatio;
+		Recipe.SpellPowerRatio = AbilityData->SpellPowerRatio;
+		Recipe.MaxHealthRatio = AbilityData->MaxHealthRatio;
+		Recipe.MissingHealthRatio = AbilityData->MissingHealthRatio;
+		switch (AbilityData->DamageType)
+		{
+		case EMOBADamageType::None: Recipe.Kind = EMOBARecipeKind::None;
+			break;
+		case EMOBADamageType::Heal:
+			// BP_AD_HealthRegen predates the bIsHealthRegen flag, keep recognising it by name
+			Recipe.Kind = (AbilityData->bIsHealthRegen || AbilityDataClass->GetFName() == FName("BP_AD_HealthRegen_C")) ? EMOBARecipeKind::HealthRegen : EMOBARecipeKind::Heal;
+			break;
+		default: Recipe.Kind = EMOBARecipeKind::Damage;
+			break;
+		}
+		return Recipe;
+	}
+}
+
+FMOBADamageRecipe UMOBAAbilityData::GetDamageRecipe(TSubclassOf<UMOBAAbilityData> AbilityDataClass)
+{
+	const UClass* DataClass = AbilityDataClass.Get();
+	if (!DataClass) return FMOBADamageRecipe();
+	if (const FMOBADamageRecipe* Recipe = DamageRecipeCache.Find(DataClass)) return *Recipe;
+#if WITH_EDITOR
+	RegisterDamageRecipeCacheFlush();
+#endif
+	return DamageRecipeCache.Add(DataClass, CompileDamageRecipe(DataClass));
+}
+
+#if WITH_EDITOR
+void UMOBAAbilityData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	// Defaults changed in the editor, recompile the recipe on next use
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		DamageRecipeCache.Remove(GetClass());
+	}
+}
+#endif
 
 // Function to check distance and whether the ability can be cast before moving
 bool UMOBAGameplayAbility::InRangeForAbility(FVector TargetLocation, AMOBACharacter* TargetCharacter) 
 {
-	if (RangeSphere) 
+	if (!MyCharacter) return false;
+	if (TargetCharacter) 
 	{
-		if (TargetCharacter) return RangeSphere->IsOverlappingComponent(TargetCharacter->GetMesh());
-		else 
+		UMOBACharacterRegistrySubsystem* CharacterRegistry = MyCharacter->GetWorld()->GetSubsystem<UMOBACharacterRegistrySubsystem>();
+		return CharacterRegistry ? CharacterRegistry->IsInRange(MyCharacter->GetActorLocation(), TargetCharacter, AbilityRange) : false;
+	}
+	return UMOBACharacterRegistrySubsystem::IsWithinRange2D(MyCharacter->GetActorLocation(), TargetLocation, AbilityRange, 0.0f);
+}
+
+void UMOBAGameplayAbility::ApplyBatchedDamage(const TArray<AMOBACharacter*>& Targets)
+{
+	if (!MyCharacter || !MyCharacter->HasAuthority() || !MyCharacter->AttributeSet || !MyCharacter->AbilitySystemComponent) return;
+	const FMOBADamageRecipe Recipe = UMOBAAbilityData::GetDamageRecipe(AbilityData);
+	if (Recipe.Kind == EMOBARecipeKind::None) return;
+	if (Recipe.Kind != EMOBARecipeKind::Damage)
+	{
+		ApplyBatchedHealing(Targets);
+		return;
+	}
+
+	// Capture the caster once for every target. Weapon damage and crit are rolled once per cast.
+	FMOBADamageSourceSnapshot SourceSnapshot(*MyCharacter->AttributeSet);
+	if (Recipe.WeaponDamageType != EWeaponDamageType::None)
+	{
+		const UMOBAAttributeSet& SourceAttributes = *MyCharacter->AttributeSet;
+		UCalculateDamage::RollWeaponDamage(Recipe, MyCharacter->NextCombatRandom(),
+			SourceAttributes.MainHandMinDamage.GetCurrentValue(), SourceAttributes.MainHandMaxDamage.GetCurrentValue(),
+			SourceAttributes.OffHandMinDamage.GetCurrentValue(), SourceAttributes.OffHandMaxDamage.GetCurrentValue(),
+			SourceAttributes.CriticalChance.GetCurrentValue(), SourceAttributes.CriticalDamage.GetCurrentValue(), SourceSnapshot);
+	}
+	FMOBADamageTargetBatch TargetBatch;
+	TArray<UAbilitySystemComponent*> TargetAbilitySystems;
+	TargetBatch.Reserve(Targets.Num());
+	TargetAbilitySystems.Reserve(Targets.Num());
+	for (AMOBACharacter* TargetCharacter : Targets)
+	{
+		if (TargetCharacter && TargetCharacter->AttributeSet && TargetCharacter->AbilitySystemComponent)
+		{
+			TargetBatch.Add(*TargetCharacter->AttributeSet);
+			TargetAbilitySystems.Add(TargetCharacter->AbilitySystemComponent);
+		}
+	}
+	TArray<float> HealthDeltas;
+	UCalculateDamage::CalculateHealthDeltas(Recipe, SourceSnapshot, TargetBatch, HealthDeltas);
+	ApplyHealthDeltas(TargetAbilitySystems, HealthDeltas);
+}
+
+void UMOBAGameplayAbility::ApplyBatchedHealing(const TArray<AMOBACharacter*>& Targets)
+{
+	if (!MyCharacter || !MyCharacter->HasAuthority() || !MyCharacter->AttributeSet || !MyCharacter->AbilitySystemComponent) return;
+	const FMOBADamageRecipe Recipe = UMOBAAbilityData::GetDamageRecipe(AbilityData);
+	if (Recipe.Kind != EMOBARecipeKind::Heal && Recipe.Kind != EMOBARecipeKind::HealthRegen) return;
+
+	// Heals never roll weapon damage, so the recipe value is the same for every target
+	const float RecipeValue = UCalculateDamage::CalculateRecipeValue(Recipe, FMOBADamageSourceSnapshot(*MyCharacter->AttributeSet));
+	TArray<float> HealingModifier, HealthRegen;
+	TArray<UAbilitySystemComponent*> TargetAbilitySystems;
+	HealingModifier.Reserve(Targets.Num());
+	HealthRegen.Reserve(Targets.Num());
+	TargetAbilitySystems.Reserve(Targets.Num());
+	for (AMOBACharacter* TargetCharacter : Targets)
+	{
+		if (TargetCharacter && TargetCharacter->AttributeSet && TargetCharacter->AbilitySystemComponent)
 		{
-			FVector MyLocation = RangeSphere->GetComponentLocation();
-			return (FVector::Dist(MyLocation, TargetLocation) <= AbilityRange);
+			HealingModifier.Add(TargetCharacter->AttributeSet->HealingModifier.GetCurrentValue());
+			HealthRegen.Add(TargetCharacter->AttributeSet->HealthRegen.GetCurrentValue());
+			TargetAbilitySystems.Add(TargetCharacter->AbilitySystemComponent);
 		}
 	}
-	return false;
+	TArray<float> HealAmounts;
+	UCalculateHealing::CalculateHealAmounts(Recipe, RecipeValue, HealingModifier, HealthRegen, HealAmounts);
+	ApplyHealthDeltas(TargetAbilitySystems, HealAmounts);
+}
+
+void UMOBAGameplayAbility::ApplyHealthDeltas(const TArray<UAbilitySystemComponent*>& TargetAbilitySystems, const TArray<float>& HealthDeltas)
+{
+	// One spec reused for every target, only the Health delta changes
+	UAbilitySystemComponent* SourceAbilitySystem = MyCharacter->AbilitySystemComponent;
+	FGameplayEffectContextHandle EffectContext = SourceAbilitySystem->MakeEffectContext();
+	EffectContext.SetAbility(this);
+	FGameplayEffectSpec HealthSpec(GetDefault<UHealthModifierEffect>(), EffectContext, GetAbilityLevel());
+	for (int32 Index = 0; Index < HealthDeltas.Num(); Index++)
+	{
+		if (HealthDeltas[Index] == 0.0f) continue;
+		HealthSpec.SetSetByCallerMagnitude(UHealthModifierEffect::HealthDeltaName, HealthDeltas[Index]);
+		SourceAbilitySystem->ApplyGameplayEffectSpecToTarget(HealthSpec, TargetAbilitySystems[Index]);
+	}
 }
 
 void UMOBAGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) 
@@ -35,21 +185,27 @@ void UMOBAGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorI
 void UMOBAGameplayAbility::PreActivate(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, FOnGameplayAbilityEnded::FDelegate* OnGameplayAbilityEndedDelegate) 
 {
 	Super::PreActivate(Handle, ActorInfo, ActivationInfo, OnGameplayAbilityEndedDelegate);
-	if (MyCharacter)
+	if (!OnGameplayAbilityEnded.IsBoundToObject(this))
+	{
+		OnGameplayAbilityEnded.AddUObject(this, &UMOBAGameplayAbility::OnAbilityEnded);
+	}
+}
+
+USphereComponent* UMOBAGameplayAbility::GetRangeSphere()
+{
+	// Range checks are distance based, the sphere only serves blueprints that still wait on its overlaps
+	if (MyCharacter && !RangeSphere)
 	{
-		RangeSphere = NewObject<USphereComponent>(CastChecked<UObject>(MyCharacter),FName("Ability Range Sphere"));
-		RangeSphere->AttachToComponent(MyCharacter->GetRootComponent(), FAttachmentTransformRules{ EAttachmentRule::SnapToTarget, EAttachmentRule::SnapToTarget, EAttachmentRule::SnapToTarget, false });
-		RangeSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-		RangeSphere->bHiddenInGame = true;
-		RangeSphere->SetSphereRadius(AbilityRange);
-		RangeSphere->bMultiBodyOverlap = 1;
-		RangeSphere->SetGenerateOverlapEvents(true);
-		MyCharacter->FinishAndRegisterComponent(RangeSphere);
+		RangeSphere = MyCharacter->AcquireRangeSphere(AbilityRange);
 	}
-	OnGameplayAbilityEnded.AddUObject(this, &UMOBAGameplayAbility::OnAbilityEnded);
+	return RangeSphere;
 }
 
 void UMOBAGameplayAbility::OnAbilityEnded(UGameplayAbility* InAbility) 
 {
-	MyCharacter->RemoveOwnedComponent(RangeSphere);
+	if (MyCharacter && RangeSphere)
+	{
+		MyCharacter->ReleaseRangeSphere(RangeSphere);
+	}
+	RangeSphere = nullptr;
 }
\ No newline at end of file
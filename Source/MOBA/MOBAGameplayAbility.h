@@ -32,12 +32,44 @@ enum class EWeaponDamageType : uint8
 	BothHands		UMETA(DisplayName = "Ability Hits with both weapons"),
 };
 
+// How an ability's execution turns its recipe into an output modifier
+enum class EMOBARecipeKind : uint8
+{
+	None,
+	Damage,
+	Heal,
+	HealthRegen,	// Heals for the target's own HealthRegen instead of base value and ratios
+};
+
+// Flattened copy of a UMOBAAbilityData class default object. Built once per class and read by the damage and healing executions.
+struct FMOBADamageRecipe
+{
+	EMOBARecipeKind Kind = EMOBARecipeKind::None;
+	EMOBADamageType DamageType = EMOBADamageType::None;
+	EWeaponDamageType WeaponDamageType = EWeaponDamageType::None;
+	float BaseValue = 0.0f;
+	float AttackPowerRatio = 0.0f;
+	float SpellPowerRatio = 0.0f;
+	float MaxHealthRatio = 0.0f;
+	float MissingHealthRatio = 0.0f;
+};
+
 UCLASS(Blueprintable)
 class MOBA_API UMOBAAbilityData : public UObject 
 {
 	GENERATED_BODY()
 
 public:
+	// Recipe for an ability data class, compiled from its class default object on first use. Kind is None for a null class.
+	static FMOBADamageRecipe GetDamageRecipe(TSubclassOf<UMOBAAbilityData> AbilityDataClass);
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Heal amount comes from the target's HealthRegen (passive regeneration) rather than BaseValue and ratios
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MOBA Ability Data")
+		bool bIsHealthRegen = false;
 	// What type of damage does the ability do, if any?
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MOBA Ability Data")
 		EMOBADamageType DamageType = EMOBADamageType::None;
@@ -76,6 +108,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MOBA Ability Properties")
 		float AbilityRange = 150.0f;
 
+	// Overlap sphere of AbilityRange. Null until GetRangeSphere is called, range checks don't need it.
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "MOBA Ability Components")
 		USphereComponent* RangeSphere;
 
@@ -88,6 +121,19 @@ public:
 	UFUNCTION(BlueprintCallable)
 		bool InRangeForAbility(FVector TargetLocation, AMOBACharacter* TargetCharacter = NULL);
 
+	// Acquire the range sphere for this activation, for blueprints that need its overlaps. Released when the ability ends.
+	UFUNCTION(BlueprintCallable, Category = "MOBA Ability")
+		USphereComponent* GetRangeSphere();
+
+	// Apply this ability's damage or healing to every target at once. The caster is captured once and mitigation is evaluated
+	// for all targets in a single pass, then each result is applied as a Health modifier. Server only.
+	UFUNCTION(BlueprintCallable, Category = "MOBA Ability")
+		void ApplyBatchedDamage(const TArray<AMOBACharacter*>& Targets);
+
+	// Heal-only batch: reads just HealingModifier and HealthRegen from each target. ApplyBatchedDamage forwards heal recipes here. Server only.
+	UFUNCTION(BlueprintCallable, Category = "MOBA Ability")
+		void ApplyBatchedHealing(const TArray<AMOBACharacter*>& Targets);
+
 	/** Called when the ability is given to an AbilitySystemComponent */
 	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 
@@ -95,4 +141,7 @@ public:
 
 protected:
 	virtual void PreActivate(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, FOnGameplayAbilityEnded::FDelegate* OnGameplayAbilityEndedDelegate) override;
+
+	// Apply precomputed health deltas through one reused UHealthModifierEffect spec. Zero deltas are skipped.
+	void ApplyHealthDeltas(const TArray<UAbilitySystemComponent*>& TargetAbilitySystems, const TArray<float>& HealthDeltas);
 };
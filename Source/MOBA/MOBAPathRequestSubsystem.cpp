@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBAPathRequestSubsystem.h"
+#include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "GameFramework/Pawn.h"
+
+FPathFollowingRequestResult UMOBAPathRequestSubsystem::RequestMove(AAIController* Controller, const FVector& Goal, float AcceptanceRadius, bool bStopOnOverlap)
+{
+	FPathFollowingRequestResult Result;
+	Result.Code = EPathFollowingRequestResult::RequestSuccessful;
+	if (!Controller)
+	{
+		Result.Code = EPathFollowingRequestResult::Failed;
+		return Result;
+	}
+	FPathAgent& Agent = Agents.FindOrAdd(Controller);
+	Agent.AcceptanceRadius = AcceptanceRadius;
+	Agent.bStopOnOverlap = bStopOnOverlap;
+	Agent.PursuitTarget = nullptr;
+	const UPathFollowingComponent* PathFollowing = Controller->GetPathFollowingComponent();
+	const bool bFollowingPath = PathFollowing && PathFollowing->GetStatus() != EPathFollowingStatus::Idle && PathFollowing->GetPath().IsValid();
+	if (bFollowingPath)
+	{
+		Result.MoveId = PathFollowing->GetCurrentRequestId();
+		const float GoalMoved = FVector::Dist2D(PathFollowing->GetPathDestination(), Goal);
+		if (GoalMoved <= GoalTolerance || FVector::DistSquared2D(Agent.RequestedGoal, Goal) <= FMath::Square(GoalTolerance))
+		{
+			Agent.bPending = false;
+			FrameCoalescedRequests++;
+			return Result;
+		}
+		if (GoalMoved <= EndpointUpdateDistance && UpdatePathEnd(Controller, Goal))
+		{
+			Agent.bPending = false;
+			Agent.RequestedGoal = Goal;
+			FrameEndpointUpdates++;
+			return Result;
+		}
+	}
+	// Keep only the latest goal until this agent may repath again, idle agents included so failed moves aren't retried every frame
+	if (GetWorld()->GetTimeSeconds() - Agent.LastRepathTime < MinRepathInterval || FrameRepaths >= MaxRepathsPerFrame)
+	{
+		Agent.PendingGoal = Goal;
+		Agent.bPending = true;
+		FrameDeferredRequests++;
+		Result.MoveId = FAIRequestID::InvalidRequest;
+		return Result;
+	}
+	Result.Code = Repath(Controller, Agent, Goal);
+	Result.MoveId = (Result.Code == EPathFollowingRequestResult::RequestSuccessful && PathFollowing) ? PathFollowing->GetCurrentRequestId() : FAIRequestID::InvalidRequest;
+	return Result;
+}
+
+void UMOBAPathRequestSubsystem::RequestPursuit(AAIController* Controller, AActor* Target, float AcceptanceRadius)
+{
+	if (!Controller || !Target) return;
+	FPathAgent& Agent = Agents.FindOrAdd(Controller);
+	if (Agent.PursuitTarget.Get() != Target)
+	{
+		// Adopt the move in progress, it is kept if it already ends near the target
+		const UPathFollowingComponent* PathFollowing = Controller->GetPathFollowingComponent();
+		Agent.PursuitTarget = Target;
+		Agent.PursuitMoveId = PathFollowing ? PathFollowing->GetCurrentRequestId() : FAIRequestID::InvalidRequest;
+		Agent.bPending = false;
+	}
+	Agent.AcceptanceRadius = AcceptanceRadius;
+	Agent.bStopOnOverlap = false;
+}
+
+void UMOBAPathRequestSubsystem::CancelMove(AAIController* Controller)
+{
+	// The agent is kept so its repath interval still applies to the next order
+	if (FPathAgent* Agent = Agents.Find(Controller))
+	{
+		Agent->bPending = false;
+		Agent->PursuitTarget = nullptr;
+	}
+}
+
+EPathFollowingRequestResult::Type UMOBAPathRequestSubsystem::Repath(AAIController* Controller, FPathAgent& Agent, const FVector& Goal)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const EPathFollowingRequestResult::Type Code = Controller->MoveToLocation(Goal, Agent.AcceptanceRadius, Agent.bStopOnOverlap, true, false, false, 0, true);
+	FramePathfindingSeconds += FPlatformTime::Seconds() - StartTime;
+	FrameRepaths++;
+	Agent.LastRepathTime = GetWorld()->GetTimeSeconds();
+	Agent.RequestedGoal = Goal;
+	Agent.bPending = false;
+	return Code;
+}
+
+bool UMOBAPathRequestSubsystem::UpdatePathEnd(AAIController* Controller, const FVector& Goal)
+{
+	UPathFollowingComponent* PathFollowing = Controller->GetPathFollowingComponent();
+	FNavPathSharedPtr Path = PathFollowing ? PathFollowing->GetPath() : nullptr;
+	// A partial path doesn't end at the goal, moving its end could leave the navmesh
+	if (!Path.IsValid() || !Path->IsValid() || Path->IsPartial() || Path->GetPathPoints().Num() < 2) return false;
+	const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	FNavLocation ProjectedGoal;
+	if (!NavigationSystem || !NavigationSystem->ProjectPointToNavigation(Goal, ProjectedGoal)) return false;
+	// The last segment must stay on the navmesh, otherwise the goal needs a real path
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	FVector HitLocation;
+	if (UNavigationSystemV1::NavigationRaycast(GetWorld(), PathPoints[PathPoints.Num() - 2].Location, ProjectedGoal.Location, HitLocation, nullptr, Controller)) return false;
+	Path->GetPathPoints().Last().Location = ProjectedGoal.Location;
+	Path->GetPathPoints().Last().NodeRef = ProjectedGoal.NodeRef;
+	// Lets the path following component pick up the new end without a new request
+	Path->DoneUpdating(ENavPathUpdateType::GoalMoved);
+	return true;
+}
+
+void UMOBAPathRequestSubsystem::UpdatePursuit(AAIController* Controller, FPathAgent& Agent, float Now)
+{
+	AActor* Target = Agent.PursuitTarget.Get();
+	APawn* Pawn = Controller->GetPawn();
+	UPathFollowingComponent* PathFollowing = Controller->GetPathFollowingComponent();
+	if (!Target || !Pawn || !PathFollowing)
+	{
+		Agent.PursuitTarget = nullptr;
+		return;
+	}
+	const bool bFollowingPath = PathFollowing->GetStatus() != EPathFollowingStatus::Idle;
+	// Something else moved the agent, it is no longer pursuing
+	if (bFollowingPath && PathFollowing->GetCurrentRequestId() != Agent.PursuitMoveId)
+	{
+		Agent.PursuitTarget = nullptr;
+		return;
+	}
+	float PawnRadius, PawnHalfHeight, TargetRadius, TargetHalfHeight;
+	Pawn->GetSimpleCollisionCylinder(PawnRadius, PawnHalfHeight);
+	Target->GetSimpleCollisionCylinder(TargetRadius, TargetHalfHeight);
+	const FVector PawnFeet = Pawn->GetActorLocation() - FVector(0.0f, 0.0f, PawnHalfHeight);
+	const FVector TargetFeet = Target->GetActorLocation() - FVector(0.0f, 0.0f, TargetHalfHeight);
+
+	// Close enough, wait here until the target moves away
+	if (FVector::DistSquared2D(PawnFeet, TargetFeet) <= FMath::Square(Agent.AcceptanceRadius + PawnRadius + TargetRadius))
+	{
+		if (bFollowingPath) Controller->StopMovement();
+		return;
+	}
+	// Nothing in the way on the navmesh, steer straight at the target
+	FVector HitLocation;
+	if (!UNavigationSystemV1::NavigationRaycast(GetWorld(), PawnFeet, TargetFeet, HitLocation, nullptr, Controller))
+	{
+		if (bFollowingPath) Controller->StopMovement();
+		Pawn->AddMovementInput((TargetFeet - PawnFeet).GetSafeNormal2D());
+		FrameDirectSteers++;
+		return;
+	}
+	// Keep the current path while the target stays around its end
+	if (bFollowingPath && FVector::DistSquared2D(PathFollowing->GetPathDestination(), TargetFeet) <= FMath::Square(PursuitCorridorRadius)) return;
+	if (Now - Agent.LastRepathTime < MinRepathInterval || FrameRepaths >= MaxRepathsPerFrame) return;
+	Repath(Controller, Agent, TargetFeet);
+	Agent.PursuitMoveId = PathFollowing->GetCurrentRequestId();
+}
+
+void UMOBAPathRequestSubsystem::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (auto It = Agents.CreateIterator(); It; ++It)
+	{
+		AAIController* Controller = It.Key().Get();
+		if (!Controller)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		FPathAgent& Agent = It.Value();
+		if (Agent.PursuitTarget.IsValid())
+		{
+			UpdatePursuit(Controller, Agent, Now);
+		}
+		else if (Agent.bPending && Now - Agent.LastRepathTime >= MinRepathInterval && FrameRepaths < MaxRepathsPerFrame)
+		{
+			Repath(Controller, Agent, Agent.PendingGoal);
+		}
+	}
+
+	// Publish this frame's totals and start counting the next
+	LastFrameRepaths = FrameRepaths;
+	LastFrameEndpointUpdates = FrameEndpointUpdates;
+	LastFrameCoalescedRequests = FrameCoalescedRequests;
+	LastFrameDeferredRequests = FrameDeferredRequests;
+	LastFrameDirectSteers = FrameDirectSteers;
+	LastFramePathfindingMs = FramePathfindingSeconds * 1000.0;
+	FrameRepaths = 0;
+	FrameEndpointUpdates = 0;
+	FrameCoalescedRequests = 0;
+	FrameDeferredRequests = 0;
+	FrameDirectSteers = 0;
+	FramePathfindingSeconds = 0.0;
+}
+
+bool UMOBAPathRequestSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && Agents.Num() > 0;
+}
+
+TStatId UMOBAPathRequestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMOBAPathRequestSubsystem, STATGROUP_Tickables);
+}
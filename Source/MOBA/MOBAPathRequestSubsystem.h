@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "AITypes.h"
+#include "MOBAPathRequestSubsystem.generated.h"
+
+class AAIController;
+
+/**
+ * Schedules move requests that are reissued every frame, like following the cursor or an ally.
+ * A goal within GoalTolerance of the path being followed, or of the goal it was requested for, is dropped. A goal that moved less than EndpointUpdateDistance
+ * moves the end of the current path instead of pathfinding again. Full repaths are limited to one per MinRepathInterval
+ * per agent and MaxRepathsPerFrame overall, the latest goal of a deferred agent is requested once it is allowed.
+ * Pursuit chases a moving actor: the agent steers straight at it while the navmesh between them is clear, and otherwise
+ * keeps one path, replanning only when the target leaves PursuitCorridorRadius around the path's end.
+ */
+UCLASS()
+class MOBA_API UMOBAPathRequestSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// Move Controller's pawn to Goal, same arguments as AAIController::MoveToLocation.
+	// MoveId is the request following a path to Goal, invalid while the goal is deferred. Code is Failed or AlreadyAtGoal when the move ended on the spot.
+	FPathFollowingRequestResult RequestMove(AAIController* Controller, const FVector& Goal, float AcceptanceRadius, bool bStopOnOverlap);
+
+	// Chase Target until it is within AcceptanceRadius of the pawn's edge, another move is requested or the move is cancelled
+	void RequestPursuit(AAIController* Controller, AActor* Target, float AcceptanceRadius);
+
+	// Forget a deferred goal or pursuit, call when the agent is told to stop or given another order
+	void CancelMove(AAIController* Controller);
+
+	// Goals this close to the current path end are duplicates
+	static constexpr float GoalTolerance = 25.0f;
+
+	// Goals that moved less than this only move the end of the current path
+	static constexpr float EndpointUpdateDistance = 150.0f;
+
+	// A pursuit path is kept while the target stays this close to its end
+	static constexpr float PursuitCorridorRadius = 300.0f;
+
+	static constexpr float MinRepathInterval = 0.1f;
+	static constexpr int32 MaxRepathsPerFrame = 4;
+
+	// Totals for the last completed frame
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinding")
+		int32 LastFrameRepaths = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinding")
+		int32 LastFrameEndpointUpdates = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinding")
+		int32 LastFrameCoalescedRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinding")
+		int32 LastFrameDeferredRequests = 0;
+
+	// Pursuing agents that steered straight at their target instead of following a path
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinding")
+		int32 LastFrameDirectSteers = 0;
+
+	// Milliseconds spent in pathfinding for full repaths
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinding")
+		float LastFramePathfindingMs = 0.0f;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+	struct FPathAgent
+	{
+		FVector PendingGoal = FVector::ZeroVector;
+		// Goal of the last repath, a partial path ends short of it
+		FVector RequestedGoal = FVector::ZeroVector;
+		float AcceptanceRadius = 0.0f;
+		float LastRepathTime = -MAX_flt;
+		bool bStopOnOverlap = false;
+		bool bPending = false;
+		TWeakObjectPtr<AActor> PursuitTarget;
+		// Move request of the current pursuit path, any other request ends the pursuit
+		FAIRequestID PursuitMoveId;
+	};
+
+	// Pathfind to Goal now
+	EPathFollowingRequestResult::Type Repath(AAIController* Controller, FPathAgent& Agent, const FVector& Goal);
+
+	// Steer, keep the path or replan toward the pursuit target
+	void UpdatePursuit(AAIController* Controller, FPathAgent& Agent, float Now);
+
+	// Move the last point of the path being followed to Goal. False when the path can't be adjusted.
+	bool UpdatePathEnd(AAIController* Controller, const FVector& Goal);
+
+	TMap<TWeakObjectPtr<AAIController>, FPathAgent> Agents;
+
+	int32 FrameRepaths = 0;
+	int32 FrameEndpointUpdates = 0;
+	int32 FrameCoalescedRequests = 0;
+	int32 FrameDeferredRequests = 0;
+	int32 FrameDirectSteers = 0;
+	double FramePathfindingSeconds = 0.0;
+};
@@ -4,6 +4,9 @@
 #include "Components/CapsuleComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Engine/LocalPlayer.h"
+#include "MOBACharacterRegistrySubsystem.h"
+#include "MOBAPathRequestSubsystem.h"
+#include "GameFramework/GameStateBase.h"
 
 AMOBAPlayerController::AMOBAPlayerController()
 {
@@ -12,20 +15,33 @@ AMOBAPlayerController::AMOBAPlayerController()
 	CurrentMouseCursor = EMouseCursor::Hand;
 	MyTeam = ETeam::BottomSide;
 	MovementType = EMovementType::None;
-	// Create a sphere component and place it at AttackTarget
+	CommandRing.SetNum(CommandRingCapacity);
+	// Deprecated, kept for Blueprints. Collision stays off so it costs no overlap updates.
 	AttackCollisionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("Attack Move Radius"), false);
-	AttackCollisionSphere->SetSphereRadius(1000.0f);
+	AttackCollisionSphere->SetSphereRadius(AttackMoveRadius);
+	AttackCollisionSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	AttackCollisionSphere->SetGenerateOverlapEvents(false);
 }
 
-void AMOBAPlayerController::PlayerTick(float DeltaTime)
+void AMOBAPlayerController::Tick(float DeltaSeconds)
 {
-	Super::PlayerTick(DeltaTime);
+	Super::Tick(DeltaSeconds);
+	// Orders are carried out on the server
+	if (!HasAuthority()) return;
+
+	// Start the next queued order once the current one is done
+	if (MovementType == EMovementType::None && QueuedCommands.Num() > 0)
+	{
+		const FMOBACommand Command = QueuedCommands[0];
+		QueuedCommands.RemoveAt(0);
+		ApplyCommand(Command);
+	}
 
 	// keep updating the destination every tick while desired
 	switch (MovementType)
 	{
 	case EMovementType::None: break;
-	case EMovementType::MoveToCursor: MoveToMouseCursor();
+	case EMovementType::MoveToCursor: MoveToMoveLocation();
 		AttackCommandActive = false;
 		break;
 	case EMovementType::MoveToFriendlyTarget: MoveToFriendlyTarget();
@@ -38,6 +54,25 @@ void AMOBAPlayerController::PlayerTick(float DeltaTime)
 		break;
 	default: AttackCommandActive = false;  break;
 	}
+}
+
+void AMOBAPlayerController::PlayerTick(float DeltaTime)
+{
+	Super::PlayerTick(DeltaTime);
+
+	// Follow the cursor while the move button is held, only ordering a new move when it points somewhere else
+	if (bMoveHeld)
+	{
+		const FMOBACursorPick& Pick = GetCursorPick();
+		if (Pick.bHitGround && FVector::DistSquared2D(Pick.GroundPoint, LastHeldMoveLocation) > FMath::Square(UMOBAPathRequestSubsystem::GoalTolerance))
+		{
+			FMOBACommand Command;
+			Command.Type = EMOBACommandType::Move;
+			Command.Location = Pick.GroundPoint;
+			IssueCommand(Command);
+		}
+	}
+	FlushCommands();
 
 	// Check if we should scroll the camera with our mouse
 	if (!bFollowPlayerCharacter) 
@@ -78,6 +113,9 @@ void AMOBAPlayerController::SetupInputComponent()
 	InputComponent->BindAction("RightClick", IE_Released, this, &AMOBAPlayerController::OnRightClickReleased);
 	InputComponent->BindAction("LeftClick", IE_Pressed, this, &AMOBAPlayerController::OnLeftClickPressed);
 	InputComponent->BindAction("LeftClick", IE_Released, this, &AMOBAPlayerController::OnLeftClickReleased);
+	// Default keyboard input "Left Shift" queues orders behind the current one while held
+	InputComponent->BindAction("QueueCommand", IE_Pressed, this, &AMOBAPlayerController::OnQueueCommandPressed);
+	InputComponent->BindAction("QueueCommand", IE_Released, this, &AMOBAPlayerController::OnQueueCommandReleased);
 	
 	// Default keyboard input "S" to stop moving and attacking
 	InputComponent->BindAction("Stop", IE_Pressed, this, &AMOBAPlayerController::Stop);
@@ -98,64 +136,240 @@ void AMOBAPlayerController::SetupInputComponent()
 }
 
 
-void AMOBAPlayerController::MoveToMouseCursor()
+const FMOBACursorPick& AMOBAPlayerController::GetCursorPick()
+{
+	if (CursorPickFrame == GFrameCounter) return CursorPick;
+	CursorPickFrame = GFrameCounter;
+	CursorPick = FMOBACursorPick();
+	FVector RayOrigin;
+	FVector RayDirection;
+	if (!DeprojectMousePositionToWorld(RayOrigin, RayDirection)) return CursorPick;
+	if (UMOBACharacterRegistrySubsystem* CharacterRegistry = GetWorld()->GetSubsystem<UMOBACharacterRegistrySubsystem>())
+	{
+		CursorPick.Character = CharacterRegistry->FindCharacterOnRay(RayOrigin, RayDirection, MyCharacter);
+	}
+	// Characters move on a plane, the ground is the height of our character's feet
+	const float GroundHeight = (MyCharacter && MyCharacter->GetCapsuleComponent()) ? MyCharacter->GetActorLocation().Z - MyCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.0f;
+	if (RayDirection.Z < -KINDA_SMALL_NUMBER)
+	{
+		CursorPick.GroundPoint = RayOrigin + RayDirection * ((GroundHeight - RayOrigin.Z) / RayDirection.Z);
+		CursorPick.bHitGround = true;
+	}
+	return CursorPick;
+}
+
+void AMOBAPlayerController::IssueCommand(FMOBACommand Command)
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	Command.Timestamp = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	if (Command.Type == EMOBACommandType::Move) LastHeldMoveLocation = Command.Location;
+	// Full, drop the oldest
+	if (CommandRingNum == CommandRingCapacity)
+	{
+		CommandRingStart = (CommandRingStart + 1) % CommandRingCapacity;
+		CommandRingNum--;
+	}
+	CommandRing[(CommandRingStart + CommandRingNum) % CommandRingCapacity] = Command;
+	CommandRingNum++;
+	CommandsIssued++;
+}
+
+void AMOBAPlayerController::IssueCastCommand(AbilityInput Ability)
+{
+	FMOBACommand Command;
+	Command.Type = EMOBACommandType::Cast;
+	Command.Ability = Ability;
+	Command.bQueued = bQueueModifierHeld;
+	IssueCommand(Command);
+}
+
+void AMOBAPlayerController::FlushCommands()
+{
+	if (CommandRingNum == 0) return;
+	TArray<FMOBACommand, TInlineAllocator<CommandRingCapacity>> Batch;
+	for (int32 Offset = 0; Offset < CommandRingNum; Offset++)
+	{
+		const FMOBACommand& Command = CommandRing[(CommandRingStart + Offset) % CommandRingCapacity];
+		// An unqueued order replaces everything given before it, casts don't change the current order
+		if (!Command.bQueued && Command.Type != EMOBACommandType::Cast) Batch.Reset();
+		Batch.Add(Command);
+	}
+	CommandRingStart = 0;
+	CommandRingNum = 0;
+	ServerIssueCommands(TArray<FMOBACommand>(Batch));
+	CommandBatchesSent++;
+}
+
+void AMOBAPlayerController::ServerIssueCommands_Implementation(const TArray<FMOBACommand>& Commands)
+{
+	// A client never sends more than its ring holds
+	if (Commands.Num() > CommandRingCapacity) return;
+	for (FMOBACommand Command : Commands)
+	{
+		if (!ValidateCommand(Command)) continue;
+		if (!Command.bQueued)
+		{
+			if (Command.Type != EMOBACommandType::Cast) QueuedCommands.Reset();
+			ApplyCommand(Command);
+		}
+		else if (MovementType == EMovementType::None && QueuedCommands.Num() == 0)
+		{
+			ApplyCommand(Command);
+		}
+		else if (QueuedCommands.Num() < MaxQueuedCommands) QueuedCommands.Add(Command);
+	}
+}
+
+bool AMOBAPlayerController::ValidateCommand(FMOBACommand& Command) const
+{
+	if (!MyCharacter) return false;
+	if (Command.Type == EMOBACommandType::AttackTarget || Command.Type == EMOBACommandType::Follow)
+	{
+		if (!IsLivingTarget(Command.Target) || Command.Target == MyCharacter) return false;
+		// The server decides whether the target is attacked or followed
+		Command.Type = MyCharacter->IsHostile(Command.Target) ? EMOBACommandType::AttackTarget : EMOBACommandType::Follow;
+	}
+	return true;
+}
+
+bool AMOBAPlayerController::IsLivingTarget(const AMOBACharacter* Target) const
+{
+	return Target && !Target->IsPendingKill() && Target->AttributeSet && Target->AttributeSet->Health.GetCurrentValue() > 0.0f;
+}
+
+void AMOBAPlayerController::ApplyCommand(const FMOBACommand& Command)
+{
+	if (!MyCharacter) return;
+	// A goal deferred or a target pursued for the previous order must not carry on into this one, casts included
+	CancelPathRequests();
+	if (Command.Type != EMOBACommandType::Cast) OrderMoveId = FAIRequestID::InvalidRequest;
+	switch (Command.Type)
+	{
+	case EMOBACommandType::Move:
+		// No target, turn off auto-attacks.
+		MyCharacter->bIsAttacking = false;
+		MyCharacter->MyEnemyTarget = NULL;
+		MyCharacter->MyFollowTarget = NULL;
+		MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
+		StopMontage();
+		MoveLocation = Command.Location;
+		MovementType = EMovementType::MoveToCursor;
+		break;
+	case EMOBACommandType::AttackTarget:
+		// Queued orders can outlive their target
+		if (!IsLivingTarget(Command.Target)) break;
+		MyCharacter->bIsAttacking = true;
+		MyCharacter->MyEnemyTarget = Command.Target;
+		MyCharacter->MyFollowTarget = NULL;
+		StopMontage();
+		AttackCommandActive = false;
+		MovementType = EMovementType::MoveToEnemyTarget;
+		MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
+		break;
+	case EMOBACommandType::AttackMove:
+		AttackLocation = Command.Location;
+		MovementType = EMovementType::MoveToAttackLocation;
+		break;
+	case EMOBACommandType::Follow:
+		if (!IsLivingTarget(Command.Target)) break;
+		MyCharacter->bIsAttacking = false;
+		MyCharacter->MyEnemyTarget = NULL;
+		MyCharacter->MyFollowTarget = Command.Target;
+		MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
+		StopMontage();
+		MovementType = EMovementType::MoveToFriendlyTarget;
+		break;
+	case EMOBACommandType::Stop:
+		if (MyAIController) MyAIController->StopMovement();
+		MyCharacter->bIsAttacking = false;
+		MyCharacter->MyEnemyTarget = NULL;
+		MyCharacter->MyFollowTarget = NULL;
+		AttackCommandActive = false;
+		MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
+		// clear flag to indicate we should stop updating the destination
+		MovementType = EMovementType::None;
+		break;
+	case EMOBACommandType::Cast:
+		if (MyCharacter->AbilitySystemComponent)
+		{
+			MyCharacter->AbilitySystemComponent->AbilityLocalInputPressed(static_cast<int32>(Command.Ability));
+		}
+		break;
+	default: break;
+	}
+}
+
+void AMOBAPlayerController::CancelPathRequests()
+{
+	if (!MyAIController) return;
+	if (UMOBAPathRequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UMOBAPathRequestSubsystem>())
+	{
+		PathRequests->CancelMove(MyAIController);
+	}
+}
+
+bool AMOBAPlayerController::IsMoveOrderDone(const FVector& Location) const
+{
+	if (!MyCharacter || !MyAIController) return false;
+	// The order's path completed, failed or was replaced, an unreachable destination ends here too
+	if (OrderMoveId.IsValid() && MyAIController->GetCurrentMoveRequestID() != OrderMoveId) return true;
+	return MyAIController->GetMoveStatus() == EPathFollowingStatus::Idle
+		&& FVector::DistSquared2D(MyCharacter->GetActorLocation(), Location) <= FMath::Square(MoveCompletionRadius);
+}
+
+void AMOBAPlayerController::RequestOrderMove(const FVector& Goal, float AcceptanceRadius)
+{
+	UMOBAPathRequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UMOBAPathRequestSubsystem>();
+	if (!PathRequests) return;
+	const FPathFollowingRequestResult Result = PathRequests->RequestMove(MyAIController, Goal, AcceptanceRadius, true);
+	if (Result.Code != EPathFollowingRequestResult::RequestSuccessful)
+	{
+		MovementType = EMovementType::None;
+		OrderMoveId = FAIRequestID::InvalidRequest;
+	}
+	else if (Result.MoveId.IsValid()) OrderMoveId = Result.MoveId;
+}
+
+void AMOBAPlayerController::MoveToMoveLocation()
 {
 	if (MyCharacter && MyAIController) 
 	{
-		// Trace to see what is under the mouse cursor
-		FHitResult Hit;
-		GetHitResultUnderCursor(ECC_Visibility, false, Hit);
-		if (Hit.bBlockingHit)
+		// Arrived, the order is done
+		if (IsMoveOrderDone(MoveLocation))
 		{
-			// We hit something, move there
-			StopMontage();
- 			UAIBlueprintHelperLibrary::SimpleMoveToLocation(MyAIController, Hit.ImpactPoint);
+			MovementType = EMovementType::None;
+			return;
 		}
+		RequestOrderMove(MoveLocation, -1.0f);
+	}
+	else 
+	{
+		MovementType = EMovementType::None;
 	}
-	
 }
 
 void AMOBAPlayerController::MoveToAttackLocation(FVector AttackTarget) 
 {
 	if (MyCharacter) 
 	{
-		// Array to store GetOverlappingActors return value 
-		TArray<AActor*> OverlappedActors;
-		// Move Attack Collision sphere to new location
-		AttackCollisionSphere->SetWorldLocation(AttackTarget);
-		// Check if there are enemies within the sphere
-		AttackCollisionSphere->GetOverlappingActors(OverlappedActors, TSubclassOf<AMOBACharacter>());
-		if (OverlappedActors.Num() > 0)
+		// Check if there are enemies near the attack location
+		UMOBACharacterRegistrySubsystem* CharacterRegistry = GetWorld()->GetSubsystem<UMOBACharacterRegistrySubsystem>();
+		AMOBACharacter* NearestHostile = CharacterRegistry ? CharacterRegistry->FindNearestHostile(MyCharacter->MyTeam, AttackTarget, AttackMoveRadius) : nullptr;
+		if (NearestHostile)
 		{
-			float minimumdistance = -1;
-			float currentdistance;
-			for (auto& OverlappedActor : OverlappedActors)
-			{
-				if (MyCharacter->IsHostile(Cast<AMOBACharacter>(OverlappedActor))) 
-				{
-					currentdistance = FVector::Dist2D(AttackCollisionSphere->GetComponentLocation(), OverlappedActor->GetActorLocation());
-					if (minimumdistance == -1)
-					{
-						minimumdistance = currentdistance;
-						MyCharacter->MyEnemyTarget = Cast<AMOBACharacter>(OverlappedActor);
-					}
-					else if (currentdistance < minimumdistance)
-					{
-						minimumdistance = currentdistance;
-						MyCharacter->MyEnemyTarget = Cast<AMOBACharacter>(OverlappedActor);
-					}
-				}
-			}
-			if (MyCharacter->MyEnemyTarget)
-			{
-				MyCharacter->bIsAttacking = true;
-				MovementType = EMovementType::MoveToEnemyTarget;
-			}
+			MyCharacter->MyEnemyTarget = NearestHostile;
+			MyCharacter->bIsAttacking = true;
+			MovementType = EMovementType::MoveToEnemyTarget;
+		}
+		// Nothing found on the way, the order is done
+		else if (IsMoveOrderDone(AttackTarget))
+		{
+			MovementType = EMovementType::None;
 		}
 		else
 		{
 			StopMontage();
-			MyAIController->MoveToLocation(AttackTarget, 10.0f, true, true, false, false, 0, true);
+			RequestOrderMove(AttackTarget, 10.0f);
 		}
 	}
 	else 
@@ -169,7 +383,10 @@ void AMOBAPlayerController::MoveToFriendlyTarget()
 	if (MyCharacter->MyFollowTarget && MyAIController) 
 	{
 		StopMontage();
-		MyAIController->MoveToLocation(MyCharacter->MyFollowTarget->GetActorLocation(), 5.0f, false, true, false, false, 0, true);
+		if (UMOBAPathRequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UMOBAPathRequestSubsystem>())
+		{
+			PathRequests->RequestPursuit(MyAIController, MyCharacter->MyFollowTarget, 5.0f);
+		}
 	}
 	// If we don't have a target, nothing to move to. Stop calling this function.
 	else 
@@ -214,62 +431,29 @@ void AMOBAPlayerController::OnRightClickPressed()
 	}
 	else 
 	{
-		// Trace to see what is under the mouse cursor
-		FHitResult HitResult;
-		// Try to get a pawn first
-		GetHitResultUnderCursor(ECC_Pawn, false, HitResult);
-		if (Cast<AMOBACharacter>(HitResult.GetActor()))
+		if (!MyCharacter)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Couldn't get a pointer to a pawn. No possessed pawn, or the pawn is the wrong class!"));
+			return;
+		}
+		// See what is under the mouse cursor, a pawn first
+		const FMOBACursorPick& Pick = GetCursorPick();
+		FMOBACommand Command;
+		Command.bQueued = bQueueModifierHeld;
+		if (Pick.Character)
 		{
-			// Check if the target hit was an attackable target
-			AActor* HitActor = HitResult.GetActor();
-			AMOBACharacter* HitCharacter = Cast<AMOBACharacter>(HitActor);
-			if (!MyCharacter)
-			{
-				UE_LOG(LogTemp, Error, TEXT("Couldn't get a pointer to a pawn. No possessed pawn, or the pawn is the wrong class!"));
-				return;
-			}
-			if (HitCharacter)
-			{
-				ETeam SourceTeam = MyCharacter->MyTeam;
-				ETeam TargetTeam = HitCharacter->MyTeam;
-				if (MyCharacter->IsHostile(HitCharacter)) // Check if the target is hostile
-				{
-					// Yes, target is hostile. Set character to attack
-					MyCharacter->bIsAttacking = true;
-					MyCharacter->MyEnemyTarget = HitCharacter;
-					MyCharacter->MyFollowTarget = NULL;
-					StopMontage();
-					MovementType = EMovementType::MoveToEnemyTarget;
-					MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
-				}
-				else
-				{
-					// No, target is friendly. Set to Follow
-					MyCharacter->bIsAttacking = false;
-					MyCharacter->MyEnemyTarget = NULL;
-					MyCharacter->MyFollowTarget = HitCharacter;
-					StopMontage();
-					MovementType = EMovementType::MoveToFriendlyTarget;
-				}
-			}
+			// Attack a hostile target, follow a friendly one
+			Command.Type = MyCharacter->IsHostile(Pick.Character) ? EMOBACommandType::AttackTarget : EMOBACommandType::Follow;
+			Command.Target = Pick.Character;
+			IssueCommand(Command);
 		}
-		else // Didn't find a pawn target, so move to location instead
+		else if (Pick.bHitGround) // Didn't find a pawn target, so move to location instead
 		{
-			GetHitResultUnderCursor(ECC_Visibility, false, HitResult);
-			if (HitResult.bBlockingHit)
-			{
-				if (MyCharacter)
-				{
-					// No target, turn off auto-attacks.
-					MyCharacter->bIsAttacking = false;
-					MyCharacter->MyEnemyTarget = NULL;
-					MyCharacter->MyFollowTarget = NULL;
-					MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
-					// set flag to keep updating destination until released
-					StopMontage();
-					MovementType = EMovementType::MoveToCursor;
-				}
-			}
+			Command.Type = EMOBACommandType::Move;
+			Command.Location = Pick.GroundPoint;
+			IssueCommand(Command);
+			// keep updating destination until released, a queued move is a single waypoint
+			bMoveHeld = !Command.bQueued;
 		}
 	}
 }
@@ -277,58 +461,38 @@ void AMOBAPlayerController::OnRightClickPressed()
 void AMOBAPlayerController::OnRightClickReleased()
 {
 	// clear flag to indicate we should stop updating the destination
-	if (MovementType == EMovementType::MoveToCursor) 
-	{
-		MovementType = EMovementType::None;
-	}
+	bMoveHeld = false;
 }
 
 void AMOBAPlayerController::OnLeftClickPressed()
 {
-	// Trace to see what is under the mouse cursor
-	FHitResult HitResult;
-	GetHitResultUnderCursor(ECC_Pawn, false, HitResult);
+	if (!MyCharacter) return;
+	// See what is under the mouse cursor
+	const FMOBACursorPick& Pick = GetCursorPick();
 	if (bAttackPending)
 	{
-		AMOBACharacter* HitCharacter = Cast<AMOBACharacter>(HitResult.GetActor());
+		FMOBACommand Command;
+		Command.bQueued = bQueueModifierHeld;
+		AMOBACharacter* HitCharacter = Pick.Character;
 		if (HitCharacter) 
 		{
-			if (MyCharacter->IsHostile(HitCharacter))
-			{
-				MyCharacter->bIsAttacking = true;
-				MyCharacter->MyEnemyTarget = HitCharacter;
-				MyCharacter->MyFocusTarget = HitCharacter;
-				MyCharacter->MyFollowTarget = NULL;
-				MovementType = EMovementType::MoveToEnemyTarget;
-			}
-			else 
-			{
-				MyCharacter->MyFollowTarget = HitCharacter;
-				MyCharacter->MyFocusTarget = HitCharacter;
-				MyCharacter->MyEnemyTarget = NULL;
-				MyCharacter->bIsAttacking = false;
-				MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
-				MovementType = EMovementType::MoveToFriendlyTarget;
-			}
+			MyCharacter->MyFocusTarget = HitCharacter;
+			Command.Type = MyCharacter->IsHostile(HitCharacter) ? EMOBACommandType::AttackTarget : EMOBACommandType::Follow;
+			Command.Target = HitCharacter;
+			IssueCommand(Command);
 		}
-		else
+		else if (Pick.bHitGround)
 		{
-			AttackLocation = HitResult.ImpactPoint;
-			MovementType = EMovementType::MoveToAttackLocation;
+			Command.Type = EMOBACommandType::AttackMove;
+			Command.Location = Pick.GroundPoint;
+			IssueCommand(Command);
 		}
 		CurrentMouseCursor = DefaultMouseCursor;
 		bAttackPending = false;
 	}
 	else 
 	{
-		if (Cast<AMOBACharacter>(HitResult.GetActor())) 
-		{
-			MyCharacter->MyFocusTarget = Cast<AMOBACharacter>(HitResult.GetActor());
-		}
-		else 
-		{
-			MyCharacter->MyFocusTarget = NULL;
-		}
+		MyCharacter->MyFocusTarget = Pick.Character;
 	}
 }
 
@@ -337,6 +501,16 @@ void AMOBAPlayerController::OnLeftClickReleased()
 	
 }
 
+void AMOBAPlayerController::OnQueueCommandPressed()
+{
+	bQueueModifierHeld = true;
+}
+
+void AMOBAPlayerController::OnQueueCommandReleased()
+{
+	bQueueModifierHeld = false;
+}
+
 // Mouse Camera Control when camera is not locked
 void AMOBAPlayerController::CalculateMouseScroll() 
 {
@@ -380,21 +554,10 @@ void AMOBAPlayerController::MoveCamera()
 // Event handler for user pressing the "Stop" input action
 void AMOBAPlayerController::Stop() 
 {
-	FVector location;
-	if (MyCharacter) 
-	{
-		if (MyAIController) 
-		{
-			MyAIController->StopMovement();
-		}
-		MyCharacter->bIsAttacking = false;
-		MyCharacter->MyEnemyTarget = NULL;
-		MyCharacter->MyFollowTarget = NULL;
-		AttackCommandActive = false;
-		MyCharacter->CombatStatusChangeDelegate.Broadcast(MyCharacter->bIsAttacking, MyCharacter->bIsInCombat);
-	}
-	// clear flag to indicate we should stop updating the destination
-	MovementType = EMovementType::None;
+	bMoveHeld = false;
+	FMOBACommand Command;
+	Command.Type = EMOBACommandType::Stop;
+	IssueCommand(Command);
 }
 
 // Event handler for user pressing the "Attack" input action
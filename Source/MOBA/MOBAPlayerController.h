@@ -23,6 +23,64 @@ enum class EMovementType : uint8
 	MoveToAttackLocation UMETA(Display Name = "Acquire an Attack Target Near a Location")
 };
 
+UENUM(BlueprintType)
+enum class EMOBACommandType : uint8
+{
+	Move,
+	AttackTarget,
+	AttackMove,
+	Follow,
+	Stop,
+	Cast
+};
+
+// One player order, produced by input on the owning client and carried out on the server
+USTRUCT(BlueprintType)
+struct FMOBACommand
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Command")
+		EMOBACommandType Type = EMOBACommandType::Stop;
+
+	// Carried out after the current order finishes instead of replacing it
+	UPROPERTY(BlueprintReadWrite, Category = "Command")
+		bool bQueued = false;
+
+	// Move and AttackMove destination
+	UPROPERTY(BlueprintReadWrite, Category = "Command")
+		FVector_NetQuantize Location = FVector::ZeroVector;
+
+	// AttackTarget and Follow target
+	UPROPERTY(BlueprintReadWrite, Category = "Command")
+		AMOBACharacter* Target = nullptr;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Command")
+		AbilityInput Ability = AbilityInput::UseAbility1;
+
+	// Server world time the order was given
+	UPROPERTY(BlueprintReadOnly, Category = "Command")
+		float Timestamp = 0.0f;
+};
+
+// What is under the mouse cursor this frame
+USTRUCT(BlueprintType)
+struct FMOBACursorPick
+{
+	GENERATED_BODY()
+
+	// Character under the cursor, picked against the character registry's capsules
+	UPROPERTY(BlueprintReadOnly, Category = "Cursor")
+		AMOBACharacter* Character = nullptr;
+
+	// Where the cursor ray meets the ground plane
+	UPROPERTY(BlueprintReadOnly, Category = "Cursor")
+		FVector GroundPoint = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Cursor")
+		bool bHitGround = false;
+};
+
 UCLASS()
 class AMOBAPlayerController : public APlayerController
 {
@@ -76,14 +134,49 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
 		FVector AttackLocation;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Targeting")
+	// Destination of the current move order
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+		FVector MoveLocation;
+
+	// A move or attack move order is done once its path finishes or fails, or the character is idle this close to its destination
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+		float MoveCompletionRadius = 100.0f;
+
+	// Attack move acquires the nearest hostile within this distance of the attack location
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Targeting")
+		float AttackMoveRadius = 1000.0f;
+
+	// No longer used for attack move and has no collision. Kept so Blueprints that read it still load.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Targeting", meta = (DeprecatedProperty, DeprecationMessage = "Attack move uses AttackMoveRadius and the character registry instead of overlaps."))
 		USphereComponent* AttackCollisionSphere;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Targeting")
 		bool AttackCommandActive;
 
+	// Cursor pick for this frame, resolved on first use without physics traces
+	const FMOBACursorPick& GetCursorPick();
+
+	// Buffer an order. Orders are sent to the server together once per frame.
+	UFUNCTION(BlueprintCallable, Category = "Command")
+		void IssueCommand(FMOBACommand Command);
+
+	// Order an ability cast, queued behind the current order while the queue modifier is held
+	UFUNCTION(BlueprintCallable, Category = "Command")
+		void IssueCastCommand(AbilityInput Ability);
+
+	UFUNCTION(Server, Reliable)
+		void ServerIssueCommands(const TArray<FMOBACommand>& Commands);
+
+	// Orders buffered and batches sent by this client
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Command")
+		int32 CommandsIssued = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Command")
+		int32 CommandBatchesSent = 0;
+
 protected:	
 	// Begin PlayerController interface
+	virtual void Tick(float DeltaSeconds) override;
 	virtual void PlayerTick(float DeltaTime) override;
 	virtual void SetupInputComponent() override;
 	// End PlayerController interface
@@ -91,8 +184,22 @@ protected:
 	//Camera Functions
 	void MoveCamera();
 
+	/** Order Functions. */
+	// Send the buffered orders as one batch, dropping those a later unqueued order replaces
+	void FlushCommands();
+	// Server: carry out an order now
+	void ApplyCommand(const FMOBACommand& Command);
+	// Drop the deferred goal or pursuit of the previous order
+	void CancelPathRequests();
+	// Server: fix up an order received from the client. False when it must be ignored.
+	bool ValidateCommand(FMOBACommand& Command) const;
+	bool IsLivingTarget(const AMOBACharacter* Target) const;
+	bool IsMoveOrderDone(const FVector& Location) const;
+	// Request a path for the current move or attack move order, ending the order if the move finished on the spot
+	void RequestOrderMove(const FVector& Goal, float AcceptanceRadius);
+
 	/** Movement Functions. */
-	void MoveToMouseCursor();
+	void MoveToMoveLocation();
 	void MoveToAttackLocation(FVector AttackTarget);
 	void MoveToFriendlyTarget();
 	void MoveToEnemyTarget();
@@ -104,6 +211,8 @@ protected:
 	void OnLeftClickPressed();
 	void OnLeftClickReleased();
 	void CalculateMouseScroll();
+	void OnQueueCommandPressed();
+	void OnQueueCommandReleased();
 
 	/*  Input handlers for keyboard action. */
 	void Stop();
@@ -120,6 +229,27 @@ protected:
 
 	// Attack Input bools
 	bool bAttackPending;
+
+	FMOBACursorPick CursorPick;
+	uint64 CursorPickFrame = MAX_uint64;
+
+	// Orders given since the last flush, oldest at CommandRingStart. The oldest is dropped when full.
+	static constexpr int32 CommandRingCapacity = 16;
+	TArray<FMOBACommand> CommandRing;
+	int32 CommandRingStart = 0;
+	int32 CommandRingNum = 0;
+
+	// Server: orders waiting for the current one to finish, orders past MaxQueuedCommands are dropped
+	TArray<FMOBACommand> QueuedCommands;
+	static constexpr int32 MaxQueuedCommands = CommandRingCapacity;
+
+	// Server: path request of the current move or attack move order, the order is done when path following moves on from it
+	FAIRequestID OrderMoveId;
+
+	// Client: right mouse button held on the ground, keep moving toward the cursor
+	bool bMoveHeld = false;
+	bool bQueueModifierHeld = false;
+	FVector LastHeldMoveLocation;
 	
 	virtual void BeginPlay() override;
 };
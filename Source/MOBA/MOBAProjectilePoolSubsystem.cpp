@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBAProjectilePoolSubsystem.h"
+#include "Projectile.h"
+#include "Engine/World.h"
+
+AProjectile* UMOBAProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* ProjectileOwner, APawn* ProjectileInstigator)
+{
+	if (!ProjectileClass) return nullptr;
+	AProjectile* Projectile = nullptr;
+	if (FMOBAProjectilePool* Pool = Pools.Find(ProjectileClass))
+	{
+		while (!Projectile && Pool->Available.Num() > 0)
+		{
+			Projectile = Pool->Available.Pop(false);
+			if (Projectile && Projectile->IsPendingKillPending()) Projectile = nullptr;
+		}
+	}
+	if (!Projectile)
+	{
+		Projectile = SpawnPooledProjectile(ProjectileClass, SpawnTransform);
+		if (!Projectile) return nullptr;
+	}
+	Projectile->bIsParked = false;
+	// Move while collision is still off so the teleport doesn't generate overlaps
+	Projectile->SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	Projectile->SetOwner(ProjectileOwner);
+	Projectile->SetInstigator(ProjectileInstigator);
+	// AMOBACharacter turns replication off for the projectiles it launches, other users get the class default back
+	if (Projectile->HasAuthority())
+	{
+		const AActor* ClassDefault = Projectile->GetClass()->GetDefaultObject<AActor>();
+		Projectile->SetReplicates(ClassDefault->GetIsReplicated());
+		Projectile->SetReplicatingMovement(ClassDefault->IsReplicatingMovement());
+	}
+	Projectile->ResetProjectile();
+	Projectile->SetPooledActive(true);
+	return Projectile;
+}
+
+void UMOBAProjectilePoolSubsystem::ReleaseProjectile(AProjectile* Projectile)
+{
+	// Parking an actor twice would hand it out to two flights
+	if (!Projectile || Projectile->IsPendingKillPending() || Projectile->bIsParked) return;
+	Projectile->bIsParked = true;
+	Projectile->SetPooledActive(false);
+	Projectile->ResetProjectile();
+	Pools.FindOrAdd(Projectile->GetClass()).Available.Add(Projectile);
+}
+
+void UMOBAProjectilePoolSubsystem::PrewarmProjectiles(TSubclassOf<AProjectile> ProjectileClass, int32 Count)
+{
+	if (!ProjectileClass) return;
+	FMOBAProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		if (AProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, FTransform::Identity))
+		{
+			Projectile->bIsParked = true;
+			Projectile->SetPooledActive(false);
+			Pool.Available.Add(Projectile);
+		}
+	}
+}
+
+AProjectile* UMOBAProjectilePoolSubsystem::SpawnPooledProjectile(UClass* ProjectileClass, const FTransform& SpawnTransform)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AProjectile* Projectile = GetWorld()->SpawnActor<AProjectile>(ProjectileClass, SpawnTransform, SpawnParameters);
+	if (Projectile)
+	{
+		Projectile->OwningPool = this;
+		// Starts parked, AcquireProjectile activates it
+		Projectile->SetActorEnableCollision(false);
+	}
+	return Projectile;
+}
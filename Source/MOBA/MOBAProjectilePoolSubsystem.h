@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MOBAProjectilePoolSubsystem.generated.h"
+
+class AProjectile;
+
+// Parked projectiles of one class
+USTRUCT()
+struct FMOBAProjectilePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TArray<AProjectile*> Available;
+};
+
+/**
+ * Reuses projectile actors instead of spawning and destroying one per shot. Released projectiles are hidden,
+ * stop colliding and ticking, and wait in a per-class pool until the next acquire.
+ */
+UCLASS()
+class MOBA_API UMOBAProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Take a projectile of ProjectileClass from its pool, spawning one if the pool is empty. Call InitializeProjectile on it next.
+	UFUNCTION(BlueprintCallable, Category = "Projectile", meta = (DeterminesOutputType = "ProjectileClass"))
+		AProjectile* AcquireProjectile(TSubclassOf<AProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* ProjectileOwner, APawn* ProjectileInstigator);
+
+	// Park a projectile until it is acquired again. Called by AProjectile::ResolveProjectile.
+	void ReleaseProjectile(AProjectile* Projectile);
+
+	// Spawn parked projectiles up front so the first shots don't hitch
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+		void PrewarmProjectiles(TSubclassOf<AProjectile> ProjectileClass, int32 Count);
+
+protected:
+	AProjectile* SpawnPooledProjectile(UClass* ProjectileClass, const FTransform& SpawnTransform);
+
+	UPROPERTY()
+		TMap<UClass*, FMOBAProjectilePool> Pools;
+};
@@ -0,0 +1,223 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBAProjectileSimulationSubsystem.h"
+#include "Projectile.h"
+#include "MOBACharacterRegistrySubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+
+void UMOBAProjectileSimulationSubsystem::AddProjectile(AProjectile* Projectile, ACharacter* Target, const FVector& Velocity, float MaxDistance)
+{
+	if (!Projectile || Projectile->SimulationIndex != INDEX_NONE) return;
+	const FVector Location = Projectile->GetActorLocation();
+	const float ProjectileSpeed = Target ? Projectile->ProjectileMovementComponent->MaxSpeed : Velocity.Size();
+	const AMOBACharacter* SourceCharacter = Cast<AMOBACharacter>(Projectile->GetOwner());
+	Projectile->SimulationIndex = Projectiles.Add(Projectile);
+	Targets.Add(Target);
+	bHoming.Add(Target != nullptr);
+	// Proxies on clients wait for the server's resolve event instead of sweeping
+	bSweep.Add(!Target && SourceCharacter && !Projectile->bIsNetProxy);
+	bSingleTarget.Add(Projectile->bIsSingleTarget);
+	SourceTeam.Add(SourceCharacter ? SourceCharacter->MyTeam : ETeam::NeutralFriendly);
+	HitCharacters.AddDefaulted();
+	ExpiryTime.Add((MaxDistance > 0.0f && ProjectileSpeed > 0.0f) ? GetWorld()->GetTimeSeconds() + MaxDistance / ProjectileSpeed : MAX_flt);
+	PositionX.Add(Location.X);
+	PositionY.Add(Location.Y);
+	PositionZ.Add(Location.Z);
+	VelocityX.Add(Velocity.X);
+	VelocityY.Add(Velocity.Y);
+	VelocityZ.Add(Velocity.Z);
+	Speed.Add(ProjectileSpeed);
+	const float Radius = Projectile->CollisionComponent ? Projectile->CollisionComponent->GetScaledSphereRadius() : 0.0f;
+	const float TargetRadius = (Target && Target->GetCapsuleComponent()) ? Target->GetCapsuleComponent()->GetScaledCapsuleRadius() : 0.0f;
+	ProjectileRadius.Add(Radius);
+	HitReach.Add(Radius + TargetRadius);
+}
+
+void UMOBAProjectileSimulationSubsystem::RemoveProjectile(AProjectile* Projectile)
+{
+	if (!Projectile || !Projectiles.IsValidIndex(Projectile->SimulationIndex) || Projectiles[Projectile->SimulationIndex] != Projectile) return;
+	const int32 Index = Projectile->SimulationIndex;
+	Projectiles.RemoveAtSwap(Index, 1, false);
+	Targets.RemoveAtSwap(Index, 1, false);
+	bHoming.RemoveAtSwap(Index, 1, false);
+	bSweep.RemoveAtSwap(Index, 1, false);
+	bSingleTarget.RemoveAtSwap(Index, 1, false);
+	SourceTeam.RemoveAtSwap(Index, 1, false);
+	HitCharacters.RemoveAtSwap(Index, 1, false);
+	ExpiryTime.RemoveAtSwap(Index, 1, false);
+	PositionX.RemoveAtSwap(Index, 1, false);
+	PositionY.RemoveAtSwap(Index, 1, false);
+	PositionZ.RemoveAtSwap(Index, 1, false);
+	VelocityX.RemoveAtSwap(Index, 1, false);
+	VelocityY.RemoveAtSwap(Index, 1, false);
+	VelocityZ.RemoveAtSwap(Index, 1, false);
+	Speed.RemoveAtSwap(Index, 1, false);
+	ProjectileRadius.RemoveAtSwap(Index, 1, false);
+	HitReach.RemoveAtSwap(Index, 1, false);
+	// The last projectile moved into the freed slot
+	if (Projectiles.IsValidIndex(Index))
+	{
+		Projectiles[Index]->SimulationIndex = Index;
+	}
+	Projectile->SimulationIndex = INDEX_NONE;
+}
+
+void UMOBAProjectileSimulationSubsystem::SetArraySizes(int32 Number)
+{
+	PositionX.SetNumZeroed(Number, false);
+	PositionY.SetNumZeroed(Number, false);
+	PositionZ.SetNumZeroed(Number, false);
+	VelocityX.SetNumZeroed(Number, false);
+	VelocityY.SetNumZeroed(Number, false);
+	VelocityZ.SetNumZeroed(Number, false);
+	Speed.SetNumZeroed(Number, false);
+	TargetX.SetNumZeroed(Number, false);
+	TargetY.SetNumZeroed(Number, false);
+	TargetZ.SetNumZeroed(Number, false);
+	DistanceToTarget2D.SetNumZeroed(Number, false);
+}
+
+void UMOBAProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	const int32 NumProjectiles = Projectiles.Num();
+	const float Now = GetWorld()->GetTimeSeconds();
+	const UMOBACharacterRegistrySubsystem* CharacterRegistry = GetWorld()->GetSubsystem<UMOBACharacterRegistrySubsystem>();
+
+	// Homing projectiles head for their target, the others for a point one velocity ahead so their direction holds
+	TargetX.SetNumUninitialized(NumProjectiles, false);
+	TargetY.SetNumUninitialized(NumProjectiles, false);
+	TargetZ.SetNumUninitialized(NumProjectiles, false);
+	TArray<bool, TInlineAllocator<64>> LostTarget;
+	LostTarget.SetNumZeroed(NumProjectiles);
+	for (int32 Index = 0; Index < NumProjectiles; Index++)
+	{
+		const ACharacter* Target = bHoming[Index] ? Targets[Index].Get() : nullptr;
+		LostTarget[Index] = bHoming[Index] && !Target;
+		const FVector Destination = Target ? Target->GetActorLocation() : FVector(PositionX[Index] + VelocityX[Index], PositionY[Index] + VelocityY[Index], PositionZ[Index] + VelocityZ[Index]);
+		TargetX[Index] = Destination.X;
+		TargetY[Index] = Destination.Y;
+		TargetZ[Index] = Destination.Z;
+	}
+	PreviousX = PositionX;
+	PreviousY = PositionY;
+
+	// Padded to a multiple of four with zeros so the vector loop needs no scalar tail
+	SetArraySizes(Align(NumProjectiles, 4));
+	Integrate(DeltaTime);
+	SetArraySizes(NumProjectiles);
+
+	// Deliver after the pass, hits and resolves can add and remove entries
+	// Flight ids tell a pooled projectile that was resolved and relaunched this frame apart from the flight that was hit
+	struct FPendingHit
+	{
+		AProjectile* Projectile;
+		uint32 FlightId;
+		ACharacter* Character;
+		bool bResolve;
+	};
+	struct FPendingExpiry
+	{
+		AProjectile* Projectile;
+		uint32 FlightId;
+	};
+	TArray<FPendingHit, TInlineAllocator<16>> PendingHits;
+	TArray<FPendingExpiry, TInlineAllocator<16>> ExpiredProjectiles;
+	TArray<FMOBASpatialGrid::FSweepHit> SweepHits;
+	for (int32 Index = 0; Index < NumProjectiles; Index++)
+	{
+		AProjectile* Projectile = Projectiles[Index];
+		const bool bExpired = Now >= ExpiryTime[Index] || LostTarget[Index];
+		if (bHoming[Index] && !LostTarget[Index] && DistanceToTarget2D[Index] - Speed[Index] * DeltaTime <= HitReach[Index])
+		{
+			PendingHits.Add(FPendingHit{ Projectile, Projectile->FlightId, Projectile->MyEnemyTarget, true });
+			continue;
+		}
+		if (bSweep[Index] && CharacterRegistry)
+		{
+			// Sweep this frame's path, stopping where the max distance ran out
+			const FVector Start(PreviousX[Index], PreviousY[Index], 0.0f);
+			FVector End(PositionX[Index], PositionY[Index], 0.0f);
+			if (bExpired && DeltaTime > 0.0f)
+			{
+				End = Start + (End - Start) * FMath::Clamp((ExpiryTime[Index] - (Now - DeltaTime)) / DeltaTime, 0.0f, 1.0f);
+			}
+			CharacterRegistry->SweepSkillshot(SourceTeam[Index], Start, End, ProjectileRadius[Index], SweepHits);
+			bool bStopped = false;
+			for (const FMOBASpatialGrid::FSweepHit& SweepHit : SweepHits)
+			{
+				if (HitCharacters[Index].Contains(SweepHit.Character)) continue;
+				HitCharacters[Index].Add(SweepHit.Character);
+				bStopped = bSingleTarget[Index];
+				PendingHits.Add(FPendingHit{ Projectile, Projectile->FlightId, SweepHit.Character, bStopped });
+				if (bStopped) break;
+			}
+			if (bStopped) continue;
+		}
+		if (bExpired)
+		{
+			ExpiredProjectiles.Add(FPendingExpiry{ Projectile, Projectile->FlightId });
+		}
+		else
+		{
+			// The actor only shows where the projectile is
+			const FVector Velocity(VelocityX[Index], VelocityY[Index], VelocityZ[Index]);
+			Projectile->SetActorLocationAndRotation(FVector(PositionX[Index], PositionY[Index], PositionZ[Index]), Velocity.Rotation());
+		}
+	}
+	for (const FPendingHit& PendingHit : PendingHits)
+	{
+		// An earlier hit's handler may have ended the flight already, or ended it and launched the actor again
+		AProjectile* Projectile = PendingHit.Projectile;
+		if (!Projectile->bIsInitialized || Projectile->FlightId != PendingHit.FlightId) continue;
+		Projectile->ReachTarget(PendingHit.Character);
+		if (PendingHit.bResolve && Projectile->bIsInitialized && Projectile->FlightId == PendingHit.FlightId) Projectile->ResolveProjectile(true);
+	}
+	for (const FPendingExpiry& Expired : ExpiredProjectiles)
+	{
+		if (Expired.Projectile->bIsInitialized && Expired.Projectile->FlightId == Expired.FlightId) Expired.Projectile->ResolveProjectile(false);
+	}
+}
+
+void UMOBAProjectileSimulationSubsystem::Integrate(float DeltaTime)
+{
+	const VectorRegister Step = VectorSetFloat1(DeltaTime);
+	const VectorRegister Tiny = VectorSetFloat1(KINDA_SMALL_NUMBER);
+	const int32 NumPadded = PositionX.Num();
+	for (int32 Index = 0; Index < NumPadded; Index += 4)
+	{
+		const VectorRegister PX = VectorLoad(PositionX.GetData() + Index);
+		const VectorRegister PY = VectorLoad(PositionY.GetData() + Index);
+		const VectorRegister PZ = VectorLoad(PositionZ.GetData() + Index);
+		const VectorRegister DX = VectorSubtract(VectorLoad(TargetX.GetData() + Index), PX);
+		const VectorRegister DY = VectorSubtract(VectorLoad(TargetY.GetData() + Index), PY);
+		const VectorRegister DZ = VectorSubtract(VectorLoad(TargetZ.GetData() + Index), PZ);
+		const VectorRegister Distance2DSquared = VectorMultiplyAdd(DX, DX, VectorMultiply(DY, DY));
+		const VectorRegister DistanceSquared = VectorMax(VectorMultiplyAdd(DZ, DZ, Distance2DSquared), Tiny);
+		VectorStore(VectorMultiply(Distance2DSquared, VectorReciprocalSqrtAccurate(VectorMax(Distance2DSquared, Tiny))), DistanceToTarget2D.GetData() + Index);
+
+		// Point the velocity at the target at full speed, then move
+		const VectorRegister ProjectileSpeed = VectorLoad(Speed.GetData() + Index);
+		const VectorRegister Scale = VectorMultiply(ProjectileSpeed, VectorReciprocalSqrtAccurate(DistanceSquared));
+		const VectorRegister VX = VectorMultiply(DX, Scale);
+		const VectorRegister VY = VectorMultiply(DY, Scale);
+		const VectorRegister VZ = VectorMultiply(DZ, Scale);
+		VectorStore(VX, VelocityX.GetData() + Index);
+		VectorStore(VY, VelocityY.GetData() + Index);
+		VectorStore(VZ, VelocityZ.GetData() + Index);
+		VectorStore(VectorMultiplyAdd(VX, Step, PX), PositionX.GetData() + Index);
+		VectorStore(VectorMultiplyAdd(VY, Step, PY), PositionY.GetData() + Index);
+		VectorStore(VectorMultiplyAdd(VZ, Step, PZ), PositionZ.GetData() + Index);
+	}
+}
+
+bool UMOBAProjectileSimulationSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && Projectiles.Num() > 0;
+}
+
+TStatId UMOBAProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMOBAProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "MOBACharacter.h"
+#include "MOBAProjectileSimulationSubsystem.generated.h"
+
+class AProjectile;
+class ACharacter;
+
+/**
+ * Moves every in-flight projectile in one pass per frame instead of a movement component and tick per actor.
+ * Projectiles are stored as structure of arrays and advanced four at a time with vector instructions.
+ * Homing projectiles hit when they reach the target's capsule. Skillshots fired by a character sweep a circle along
+ * each frame's path against the character registry and hit hostiles in time of impact order, piercing unless single target.
+ * Projectiles with a max distance expire at a time computed from their speed when they are added.
+ * The actors are only moved to the simulated position and don't collide while simulated unless bKeepCollisionWhenSimulated is set.
+ */
+UCLASS()
+class MOBA_API UMOBAProjectileSimulationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// Start simulating an initialized projectile. Homing when Target is set, otherwise it keeps its velocity.
+	void AddProjectile(AProjectile* Projectile, ACharacter* Target, const FVector& Velocity, float MaxDistance);
+	void RemoveProjectile(AProjectile* Projectile);
+
+	int32 Num() const { return Projectiles.Num(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+	// Advance every projectile by DeltaTime. Entries at or past NumProjectiles are padding.
+	void Integrate(float DeltaTime);
+	void SetArraySizes(int32 Number);
+
+	UPROPERTY()
+		TArray<AProjectile*> Projectiles;
+
+	TArray<TWeakObjectPtr<ACharacter>> Targets;
+	TArray<bool> bHoming;
+	// Skillshot collision is tested by sweeps against characters hostile to SourceTeam
+	TArray<bool> bSweep;
+	TArray<bool> bSingleTarget;
+	TArray<ETeam> SourceTeam;
+	// Characters a piercing skillshot already hit, so each is hit once
+	TArray<TArray<AMOBACharacter*>> HitCharacters;
+	// World time the projectile has travelled its max distance, MAX_flt when unlimited
+	TArray<float> ExpiryTime;
+	TArray<float> ProjectileRadius;
+
+	TArray<float> PositionX, PositionY, PositionZ;
+	TArray<float> VelocityX, VelocityY, VelocityZ;
+	TArray<float> Speed;
+	// Distance from the target's center at which a homing projectile hits
+	TArray<float> HitReach;
+
+	// Filled every frame: where each projectile is heading, and its 2D distance there before moving
+	TArray<float> TargetX, TargetY, TargetZ;
+	TArray<float> DistanceToTarget2D;
+	TArray<float> PreviousX, PreviousY;
+};
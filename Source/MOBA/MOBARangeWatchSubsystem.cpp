@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBARangeWatchSubsystem.h"
+#include "MOBACharacter.h"
+#include "Components/CapsuleComponent.h"
+
+int32 UMOBARangeWatchSubsystem::AddWatch(AMOBACharacter* Source, AMOBACharacter* Target, const FVector& TargetLocation, float Range, FMOBARangeWatchDelegate OnInRange, FMOBARangeWatchDelegate OnCancelled)
+{
+	if (!Source) return INDEX_NONE;
+	const int32 Handle = NextWatchHandle++;
+	Watches.Add(FWatch{ Handle, Source, Target, TargetLocation, Range, MoveTemp(OnInRange), MoveTemp(OnCancelled) });
+	return Handle;
+}
+
+void UMOBARangeWatchSubsystem::RemoveWatch(int32 WatchHandle)
+{
+	const int32 Index = Watches.IndexOfByPredicate([WatchHandle](const FWatch& Watch) { return Watch.Handle == WatchHandle; });
+	if (Index != INDEX_NONE) Watches.RemoveAtSwap(Index, 1, false);
+}
+
+void UMOBARangeWatchSubsystem::Tick(float DeltaTime)
+{
+	// Drop watches whose characters are gone, their owners still need to hear about it
+	TArray<FMOBARangeWatchDelegate, TInlineAllocator<8>> CancelledCallbacks;
+	for (int32 Index = Watches.Num() - 1; Index >= 0; Index--)
+	{
+		if (!Watches[Index].Source.IsValid() || (!Watches[Index].Target.IsValid() && !Watches[Index].Target.IsExplicitlyNull()))
+		{
+			CancelledCallbacks.Add(MoveTemp(Watches[Index].OnCancelled));
+			Watches.RemoveAtSwap(Index, 1, false);
+		}
+	}
+	for (FMOBARangeWatchDelegate& Callback : CancelledCallbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+	const int32 NumWatches = Watches.Num();
+	// Padded to a multiple of four so the vector loop needs no scalar tail
+	const int32 NumPadded = Align(NumWatches, 4);
+	SourceX.SetNumZeroed(NumPadded, false);
+	SourceY.SetNumZeroed(NumPadded, false);
+	TargetX.SetNumZeroed(NumPadded, false);
+	TargetY.SetNumZeroed(NumPadded, false);
+	ReachSquared.SetNumZeroed(NumPadded, false);
+	DistanceSquared.SetNumUninitialized(NumPadded, false);
+	for (int32 Index = 0; Index < NumWatches; Index++)
+	{
+		const FWatch& Watch = Watches[Index];
+		const FVector SourceLocation = Watch.Source->GetActorLocation();
+		SourceX[Index] = SourceLocation.X;
+		SourceY[Index] = SourceLocation.Y;
+		float Reach = Watch.Range;
+		if (const AMOBACharacter* Target = Watch.Target.Get())
+		{
+			const FVector TargetLocation = Target->GetActorLocation();
+			TargetX[Index] = TargetLocation.X;
+			TargetY[Index] = TargetLocation.Y;
+			Reach += Target->GetCapsuleComponent() ? Target->GetCapsuleComponent()->GetScaledCapsuleRadius() : 0.0f;
+		}
+		else
+		{
+			TargetX[Index] = Watch.TargetLocation.X;
+			TargetY[Index] = Watch.TargetLocation.Y;
+		}
+		ReachSquared[Index] = FMath::Square(Reach);
+	}
+
+	for (int32 Index = 0; Index < NumPadded; Index += 4)
+	{
+		const VectorRegister DeltaX = VectorSubtract(VectorLoad(TargetX.GetData() + Index), VectorLoad(SourceX.GetData() + Index));
+		const VectorRegister DeltaY = VectorSubtract(VectorLoad(TargetY.GetData() + Index), VectorLoad(SourceY.GetData() + Index));
+		VectorStore(VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY)), DistanceSquared.GetData() + Index);
+	}
+
+	// Collect first, callbacks may add or remove watches
+	TArray<FMOBARangeWatchDelegate, TInlineAllocator<8>> InRangeCallbacks;
+	for (int32 Index = NumWatches - 1; Index >= 0; Index--)
+	{
+		if (DistanceSquared[Index] <= ReachSquared[Index])
+		{
+			InRangeCallbacks.Add(MoveTemp(Watches[Index].OnInRange));
+			Watches.RemoveAtSwap(Index, 1, false);
+		}
+	}
+	for (FMOBARangeWatchDelegate& Callback : InRangeCallbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+bool UMOBARangeWatchSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && Watches.Num() > 0;
+}
+
+TStatId UMOBARangeWatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMOBARangeWatchSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "MOBARangeWatchSubsystem.generated.h"
+
+class AMOBACharacter;
+
+DECLARE_DELEGATE(FMOBARangeWatchDelegate);
+
+/**
+ * Watches for a character to come within range of a target character or location. All watches are tested once per
+ * frame in a single vectorized 2D distance pass. A watch fires its callback once and is then removed. If Source or
+ * Target is destroyed first, OnCancelled fires instead.
+ */
+UCLASS()
+class MOBA_API UMOBARangeWatchSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	// Watch Source until it is within Range of Target's capsule, or of TargetLocation when Target is null. Returns a handle for RemoveWatch.
+	int32 AddWatch(AMOBACharacter* Source, AMOBACharacter* Target, const FVector& TargetLocation, float Range, FMOBARangeWatchDelegate OnInRange, FMOBARangeWatchDelegate OnCancelled = FMOBARangeWatchDelegate());
+	void RemoveWatch(int32 WatchHandle);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+	struct FWatch
+	{
+		int32 Handle;
+		TWeakObjectPtr<AMOBACharacter> Source;
+		TWeakObjectPtr<AMOBACharacter> Target;
+		FVector TargetLocation;
+		float Range;
+		FMOBARangeWatchDelegate OnInRange;
+		FMOBARangeWatchDelegate OnCancelled;
+	};
+
+	TArray<FWatch> Watches;
+
+	// Per frame structure of arrays gathered from Watches for the distance pass
+	TArray<float> SourceX, SourceY, TargetX, TargetY, ReachSquared;
+	TArray<float> DistanceSquared;
+
+	int32 NextWatchHandle = 1;
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBARegenerationSubsystem.h"
+#include "MOBAAttributeSet.h"
+#include "AbilitySystemComponent.h"
+
+void UMOBARegenerationSubsystem::RegisterAttributeSet(UMOBAAttributeSet* AttributeSet)
+{
+	if (AttributeSet) RegisteredAttributeSets.AddUnique(AttributeSet);
+}
+
+void UMOBARegenerationSubsystem::UnregisterAttributeSet(UMOBAAttributeSet* AttributeSet)
+{
+	RegisteredAttributeSets.RemoveSwap(AttributeSet);
+}
+
+void UMOBARegenerationSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceLastStep += DeltaTime;
+	if (TimeSinceLastStep < RegenInterval) return;
+	Regenerate(TimeSinceLastStep);
+	TimeSinceLastStep = 0.0f;
+}
+
+bool UMOBARegenerationSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && RegisteredAttributeSets.Num() > 0;
+}
+
+TStatId UMOBARegenerationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMOBARegenerationSubsystem, STATGROUP_Tickables);
+}
+
+void UMOBARegenerationSubsystem::Regenerate(float StepSeconds)
+{
+	// HealthRegen and ManaRegen are amounts per 5 seconds
+	const float RegenScale = StepSeconds / 5.0f;
+	for (UMOBAAttributeSet* AttributeSet : RegisteredAttributeSets)
+	{
+		UAbilitySystemComponent* AbilitySystemComponent = AttributeSet ? AttributeSet->GetOwningAbilitySystemComponent() : nullptr;
+		if (!AbilitySystemComponent) continue;
+		const float Health = AttributeSet->Health.GetCurrentValue();
+		const float MaxHealth = AttributeSet->MaxHealth.GetCurrentValue();
+		if (Health > 0.0f && Health < MaxHealth)
+		{
+			const float HealthGain = AttributeSet->HealthRegen.GetCurrentValue() * RegenScale * AttributeSet->HealingModifier.GetCurrentValue();
+			if (HealthGain > 0.0f)
+			{
+				// Through the ability system so modifiers and change delegates see it. PreAttributeChange marks Health dirty.
+				AbilitySystemComponent->ApplyModToAttributeUnsafe(AttributeSet->HealthAttribute(), EGameplayModOp::Additive, FMath::Min(HealthGain, MaxHealth - Health));
+			}
+		}
+		const float Mana = AttributeSet->Mana.GetCurrentValue();
+		const float MaxMana = AttributeSet->MaxMana.GetCurrentValue();
+		if (Health > 0.0f && Mana < MaxMana)
+		{
+			const float ManaGain = AttributeSet->ManaRegen.GetCurrentValue() * RegenScale;
+			if (ManaGain > 0.0f)
+			{
+				AbilitySystemComponent->ApplyModToAttributeUnsafe(AttributeSet->ManaAttribute(), EGameplayModOp::Additive, FMath::Min(ManaGain, MaxMana - Mana));
+				AttributeSet->MarkAttributeDirty(EMOBAAttribute::Mana);
+			}
+		}
+	}
+}
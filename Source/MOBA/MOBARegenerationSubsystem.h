@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "MOBARegenerationSubsystem.generated.h"
+
+class UMOBAAttributeSet;
+
+/**
+ * Integrates HealthRegen and ManaRegen for every registered attribute set in one pass at a fixed rate.
+ * Replaces the per-character periodic regen abilities. Only runs on the server.
+ */
+UCLASS()
+class MOBA_API UMOBARegenerationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterAttributeSet(UMOBAAttributeSet* AttributeSet);
+	void UnregisterAttributeSet(UMOBAAttributeSet* AttributeSet);
+
+	// Seconds between regeneration steps
+	float RegenInterval = 0.5f;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+	// Apply StepSeconds worth of regeneration to every registered attribute set
+	void Regenerate(float StepSeconds);
+
+	UPROPERTY()
+		TArray<UMOBAAttributeSet*> RegisteredAttributeSets;
+
+	float TimeSinceLastStep = 0.0f;
+};
@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MOBASpatialGrid.h"
+#include "MOBACharacterRegistrySubsystem.h"
+#include "Components/CapsuleComponent.h"
+
+void FMOBASpatialGrid::Initialize(const FBox2D& InBounds, float InCellSize)
+{
+	CellSize = InCellSize;
+	InvCellSize = 1.0f / InCellSize;
+	Origin = InBounds.Min;
+	const FVector2D Size = InBounds.GetSize();
+	NumCellsX = FMath::Max(FMath::CeilToInt(Size.X * InvCellSize), 1);
+	NumCellsY = FMath::Max(FMath::CeilToInt(Size.Y * InvCellSize), 1);
+	Cells.Reset();
+	Cells.SetNum(NumCellsX * NumCellsY);
+}
+
+int32 FMOBASpatialGrid::GetCellIndex(const FVector2D& Location) const
+{
+	const int32 CellX = FMath::Clamp(FMath::FloorToInt((Location.X - Origin.X) * InvCellSize), 0, NumCellsX - 1);
+	const int32 CellY = FMath::Clamp(FMath::FloorToInt((Location.Y - Origin.Y) * InvCellSize), 0, NumCellsY - 1);
+	return CellY * NumCellsX + CellX;
+}
+
+void FMOBASpatialGrid::GetCellRange(const FVector2D& Location, float Radius, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+	OutMin.X = FMath::Clamp(FMath::FloorToInt((Location.X - Radius - Origin.X) * InvCellSize), 0, NumCellsX - 1);
+	OutMin.Y = FMath::Clamp(FMath::FloorToInt((Location.Y - Radius - Origin.Y) * InvCellSize), 0, NumCellsY - 1);
+	OutMax.X = FMath::Clamp(FMath::FloorToInt((Location.X + Radius - Origin.X) * InvCellSize), 0, NumCellsX - 1);
+	OutMax.Y = FMath::Clamp(FMath::FloorToInt((Location.Y + Radius - Origin.Y) * InvCellSize), 0, NumCellsY - 1);
+}
+
+void FMOBASpatialGrid::Add(AMOBACharacter* Character, const FVector& Location, bool bAlive)
+{
+	const FVector2D Location2D(Location);
+	const int32 CellIndex = GetCellIndex(Location2D);
+	Character->SpatialCellIndex = CellIndex;
+	const float Radius = Character->GetCapsuleComponent() ? Character->GetCapsuleComponent()->GetScaledCapsuleRadius() : 0.0f;
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, Radius);
+	Character->SpatialCellSlot = Cells[CellIndex].Add(FEntry{ Character, Location2D, Character->MyTeam, bAlive, Radius });
+}
+
+void FMOBASpatialGrid::Remove(AMOBACharacter* Character)
+{
+	if (!Cells.IsValidIndex(Character->SpatialCellIndex)) return;
+	TArray<FEntry>& Cell = Cells[Character->SpatialCellIndex];
+	const int32 Slot = Character->SpatialCellSlot;
+	Cell.RemoveAtSwap(Slot, 1, false);
+	// The last entry of the cell moved into the freed slot
+	if (Cell.IsValidIndex(Slot))
+	{
+		Cell[Slot].Character->SpatialCellSlot = Slot;
+	}
+	Character->SpatialCellIndex = INDEX_NONE;
+	Character->SpatialCellSlot = INDEX_NONE;
+}
+
+void FMOBASpatialGrid::Update(AMOBACharacter* Character, const FVector& Location, bool bAlive)
+{
+	const FVector2D Location2D(Location);
+	const int32 CellIndex = GetCellIndex(Location2D);
+	if (CellIndex == Character->SpatialCellIndex)
+	{
+		FEntry& Entry = Cells[CellIndex][Character->SpatialCellSlot];
+		Entry.Location = Location2D;
+		Entry.Team = Character->MyTeam;
+		Entry.bAlive = bAlive;
+		return;
+	}
+	Remove(Character);
+	Add(Character, Location, bAlive);
+}
+
+AMOBACharacter* FMOBASpatialGrid::FindNearestHostile(ETeam Team, const FVector& Location, float Radius) const
+{
+	const FVector2D Location2D(Location);
+	FIntPoint MinCell, MaxCell;
+	GetCellRange(Location2D, Radius, MinCell, MaxCell);
+	AMOBACharacter* NearestCharacter = nullptr;
+	float NearestDistanceSquared = FMath::Square(Radius);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			for (const FEntry& Entry : Cells[CellY * NumCellsX + CellX])
+			{
+				if (!Entry.bAlive || !UMOBACharacterRegistrySubsystem::IsHostileTeam(Team, Entry.Team)) continue;
+				const float DistanceSquared = FVector2D::DistSquared(Location2D, Entry.Location);
+				if (DistanceSquared <= NearestDistanceSquared)
+				{
+					NearestDistanceSquared = DistanceSquared;
+					NearestCharacter = Entry.Character;
+				}
+			}
+		}
+	}
+	return NearestCharacter;
+}
+
+void FMOBASpatialGrid::SweepCircle(ETeam Team, const FVector2D& Start, const FVector2D& End, float Radius, TArray<FSweepHit>& OutHits) const
+{
+	OutHits.Reset();
+	// Cells under the swept path's bounding box
+	const FVector2D Center = (Start + End) * 0.5f;
+	const FVector2D HalfExtent = (End - Start).GetAbs() * 0.5f + FVector2D(Radius + MaxEntryRadius, Radius + MaxEntryRadius);
+	FIntPoint MinCell, MaxCell, UnusedCell;
+	GetCellRange(Center - HalfExtent, 0.0f, MinCell, UnusedCell);
+	GetCellRange(Center + HalfExtent, 0.0f, UnusedCell, MaxCell);
+
+	const FVector2D Direction = End - Start;
+	const float A = Direction.SizeSquared();
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			for (const FEntry& Entry : Cells[CellY * NumCellsX + CellX])
+			{
+				if (!Entry.bAlive || !UMOBACharacterRegistrySubsystem::IsHostileTeam(Team, Entry.Team)) continue;
+				// Solve |Start + t * Direction - Entry| = Radius + Entry.Radius for the first t in [0, 1]
+				const FVector2D Offset = Start - Entry.Location;
+				const float C = Offset.SizeSquared() - FMath::Square(Radius + Entry.Radius);
+				if (C <= 0.0f)
+				{
+					OutHits.Add(FSweepHit{ Entry.Character, 0.0f });
+					continue;
+				}
+				if (A <= SMALL_NUMBER) continue;
+				const float B = 2.0f * (Offset | Direction);
+				const float Discriminant = B * B - 4.0f * A * C;
+				if (Discriminant < 0.0f) continue;
+				const float Time = (-B - FMath::Sqrt(Discriminant)) / (2.0f * A);
+				if (Time >= 0.0f && Time <= 1.0f)
+				{
+					OutHits.Add(FSweepHit{ Entry.Character, Time });
+				}
+			}
+		}
+	}
+	OutHits.Sort([](const FSweepHit& Left, const FSweepHit& Right) { return Left.Time < Right.Time; });
+}
+
+void FMOBASpatialGrid::GetEntriesInRadius(const FVector& Location, float Radius, TArray<const FEntry*>& OutEntries) const
+{
+	const FVector2D Location2D(Location);
+	FIntPoint MinCell, MaxCell;
+	GetCellRange(Location2D, Radius, MinCell, MaxCell);
+	const float RadiusSquared = FMath::Square(Radius);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			for (const FEntry& Entry : Cells[CellY * NumCellsX + CellX])
+			{
+				if (Entry.bAlive && FVector2D::DistSquared(Location2D, Entry.Location) <= RadiusSquared)
+				{
+					OutEntries.Add(&Entry);
+				}
+			}
+		}
+	}
+}
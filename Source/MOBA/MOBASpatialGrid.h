@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MOBACharacter.h"
+
+/**
+ * Uniform 2D grid over the map holding every registered character. Characters are moved between cells only when
+ * they cross a cell border, and radius queries visit just the cells the query circle overlaps.
+ * Positions outside the bounds are clamped into the edge cells, which stay correct but get slower.
+ */
+struct MOBA_API FMOBASpatialGrid
+{
+	struct FEntry
+	{
+		AMOBACharacter* Character;
+		FVector2D Location;
+		ETeam Team;
+		bool bAlive;
+		float Radius;
+	};
+
+	struct FSweepHit
+	{
+		AMOBACharacter* Character;
+		// Fraction of the sweep at which the circles first touch, 0 when already touching at the start
+		float Time;
+	};
+
+	void Initialize(const FBox2D& InBounds, float InCellSize);
+	bool IsInitialized() const { return Cells.Num() > 0; }
+
+	void Add(AMOBACharacter* Character, const FVector& Location, bool bAlive);
+	void Remove(AMOBACharacter* Character);
+	void Update(AMOBACharacter* Character, const FVector& Location, bool bAlive);
+
+	// Closest living character hostile to Team within Radius of Location. Null if there is none.
+	AMOBACharacter* FindNearestHostile(ETeam Team, const FVector& Location, float Radius) const;
+
+	// Living characters hostile to Team touched by a circle of Radius moving from Start to End, against their capsule radius.
+	// OutHits is sorted by time of impact.
+	void SweepCircle(ETeam Team, const FVector2D& Start, const FVector2D& End, float Radius, TArray<FSweepHit>& OutHits) const;
+
+	// Every living character within Radius of Location, appended to OutEntries
+	void GetEntriesInRadius(const FVector& Location, float Radius, TArray<const FEntry*>& OutEntries) const;
+
+protected:
+	int32 GetCellIndex(const FVector2D& Location) const;
+	void GetCellRange(const FVector2D& Location, float Radius, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+	FVector2D Origin = FVector2D::ZeroVector;
+	float CellSize = 1000.0f;
+	float InvCellSize = 0.001f;
+	int32 NumCellsX = 0;
+	int32 NumCellsY = 0;
+	TArray<TArray<FEntry>> Cells;
+
+	// Largest entry radius seen, widens the cells a sweep has to visit
+	float MaxEntryRadius = 0.0f;
+};
@@ -3,6 +3,10 @@
 
 #include "Projectile.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Components/CapsuleComponent.h"
+#include "MOBAProjectilePoolSubsystem.h"
+#include "MOBAProjectileSimulationSubsystem.h"
+#include "MOBACharacter.h"
 
 AProjectile::AProjectile()
 {
@@ -33,6 +37,7 @@ AProjectile::AProjectile()
 	ProjectileMovementComponent->Friction = 0;
 	InitialLifeSpan = 0.0f; // Projectile lives until it hits its target.
 	TargetLocation = FVector{ 0,0,0 };
+	HitTarget = NULL;
 }
 
 // Called when the game starts or when spawned
@@ -42,16 +47,79 @@ void AProjectile::BeginPlay()
 	SpawnedLocation = GetActorLocation();
 }
 
+void AProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMOBAProjectileSimulationSubsystem* Simulation = GetWorld() ? GetWorld()->GetSubsystem<UMOBAProjectileSimulationSubsystem>() : nullptr)
+	{
+		Simulation->RemoveProjectile(this);
+	}
+	// Destroyed mid flight or before it was initialized, still let listeners know
+	if (bIsInitialized || OnProjectileResolved.IsBound())
+	{
+		bIsInitialized = false;
+		OnProjectileResolved.Broadcast(this, false);
+		OnProjectileResolved.Clear();
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AProjectile::ResolveProjectile(bool bHitTarget)
+{
+	// Already ended, a second resolve would park the actor twice
+	if (bIsParked || IsPendingKillPending()) return;
+	if (UMOBAProjectileSimulationSubsystem* Simulation = GetWorld() ? GetWorld()->GetSubsystem<UMOBAProjectileSimulationSubsystem>() : nullptr)
+	{
+		Simulation->RemoveProjectile(this);
+	}
+	bIsInitialized = false;
+	OnProjectileResolved.Broadcast(this, bHitTarget);
+	OnProjectileResolved.Clear();
+	if (UMOBAProjectilePoolSubsystem* Pool = OwningPool.Get())
+	{
+		Pool->ReleaseProjectile(this);
+	}
+	else Destroy();
+}
+
+void AProjectile::ResetProjectile()
+{
+	bIsInitialized = false;
+	bIsSingleTarget = false;
+	MyEnemyTarget = NULL;
+	HitTarget = NULL;
+	bIsNetProxy = false;
+	NetProjectileId = 0;
+	SpawnedLocation = GetActorLocation();
+	TargetLocation = FVector{ 0,0,0 };
+	MaxDistance = 0.0f;
+	ProjectileMovementComponent->bIsHomingProjectile = false;
+	ProjectileMovementComponent->HomingTargetComponent = NULL;
+	ProjectileMovementComponent->Velocity = FVector{ 0,0,0 };
+}
+
+void AProjectile::SetPooledActive(bool bActive)
+{
+	SetActorHiddenInGame(!bActive);
+	SetActorEnableCollision(bActive);
+	SetActorTickEnabled(bActive);
+	if (bActive)
+	{
+		ProjectileMovementComponent->SetUpdatedComponent(CollisionComponent);
+		ProjectileMovementComponent->Activate(true);
+	}
+	else ProjectileMovementComponent->Deactivate();
+}
+
 // Called every frame
 void AProjectile::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	if (TargetLocation != FVector{ 0,0,0 }) 
+	if (TargetLocation != FVector{ 0,0,0 } && SimulationIndex == INDEX_NONE) 
 	{
 		// We have a set distance, check if we reached it
 		if (FVector::Dist2D(SpawnedLocation,GetActorLocation()) >= MaxDistance) 
 		{
-			Destroy();
+			ResolveProjectile(false);
 		}
 	}	
 }
@@ -59,12 +127,15 @@ void AProjectile::Tick(float DeltaTime)
 // Update the Destination based on the target's current position
 void AProjectile::InitializeProjectile(bool IsSingleTarget, ACharacter* CharacterTarget, FVector Direction, float InMaxDistance)
 {
+	FlightId++;
 	// If Target is specified, then the projectile is a homing projectile
 	if (CharacterTarget)
 	{
 		ProjectileMovementComponent->bIsHomingProjectile = true;
 		ProjectileMovementComponent->HomingAccelerationMagnitude = 10000; // Instantly hit max speed
 		ProjectileMovementComponent->HomingTargetComponent = CharacterTarget->GetRootComponent();
+		// Start at full speed toward the target, pooled projectiles had their velocity cleared on release
+		ProjectileMovementComponent->Velocity = ProjectileMovementComponent->InitialSpeed * (CharacterTarget->GetActorLocation() - GetActorLocation()).GetSafeNormal();
 		bIsSingleTarget = IsSingleTarget;
 		MyEnemyTarget = CharacterTarget;
 		bIsInitialized = true;
@@ -83,7 +154,21 @@ void AProjectile::InitializeProjectile(bool IsSingleTarget, ACharacter* Characte
 		}
 		bIsInitialized = true;
 	}
-	else Destroy();
+	else
+	{
+		ResolveProjectile(false);
+		return;
+	}
+	UMOBAProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UMOBAProjectileSimulationSubsystem>();
+	if (bUseSimulationManager && Simulation)
+	{
+		// The simulation moves the actor and tests hits by distance or skillshot sweeps, switch off per actor movement and ticking.
+		// Skillshots without an owning character can't be swept by team, they keep their collision so overlaps still fire.
+		ProjectileMovementComponent->Deactivate();
+		SetActorTickEnabled(false);
+		if (MyEnemyTarget || (Cast<AMOBACharacter>(GetOwner()) && !bKeepCollisionWhenSimulated)) SetActorEnableCollision(false);
+		Simulation->AddProjectile(this, MyEnemyTarget, ProjectileMovementComponent->Velocity, MaxDistance);
+	}
 }
 
 void AProjectile::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult) 
@@ -96,15 +181,21 @@ void AProjectile::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* Ot
 			ACharacter* othercharacter = Cast<ACharacter>(OtherActor);
 			if (othercharacter == MyEnemyTarget)
 			{
-				// We made it to the target, check if its the mesh 
-				if (othercharacter->GetMesh() == Cast<USkeletalMeshComponent>(OtherComp))
+				// We made it to the target, check if its the capsule (character meshes don't generate overlaps)
+				if (othercharacter->GetCapsuleComponent() == OtherComp)
 				{
-					// broadcast a delegate and destroy ourself
-					this->OnTargetReached(MyEnemyTarget);
-					this->Destroy();
+					// broadcast a delegate and end the flight
+					ReachTarget(MyEnemyTarget);
+					ResolveProjectile(true);
 				}
 
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+void AProjectile::ReachTarget(ACharacter* InTarget)
+{
+	HitTarget = InTarget;
+	if (!bIsNetProxy) OnTargetReached(InTarget);
+}
@@ -9,6 +9,45 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Projectile.generated.h"
 
+class AProjectile;
+class UMOBAProjectilePoolSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FProjectileResolved, AProjectile*, Projectile, bool, bHitTarget);
+
+// Everything a client needs to simulate a launched projectile itself. Speed comes from the class defaults.
+USTRUCT()
+struct FMOBAProjectileSpawnEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TSubclassOf<AProjectile> ProjectileClass;
+
+	// Matches the resolve event to this flight, unique per launching character
+	UPROPERTY()
+		uint16 ProjectileId = 0;
+
+	UPROPERTY()
+		FVector_NetQuantize Origin;
+
+	UPROPERTY()
+		FVector_NetQuantizeNormal Direction;
+
+	// Null for skillshots
+	UPROPERTY()
+		ACharacter* Target = nullptr;
+
+	UPROPERTY()
+		float MaxDistance = 0.0f;
+
+	// Server world time of the launch, clients advance the projectile by the time the event took to arrive
+	UPROPERTY()
+		float SpawnTime = 0.0f;
+
+	UPROPERTY()
+		bool bIsSingleTarget = false;
+};
+
 /**
  * 
  */
@@ -25,6 +64,7 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// Called every frame
@@ -48,6 +88,32 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Targeting")
 		float MaxDistance;
 
+	// Last character this flight reached, null if it reached none
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Targeting")
+		ACharacter* HitTarget;
+
+	// Client side copy launched from a spawn event. It only shows the flight, hits come from the server's resolve event.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
+		bool bIsNetProxy = false;
+
+	// Id of this flight in the launching character's spawn and resolve events
+	uint16 NetProjectileId = 0;
+
+	// Move and hit test in UMOBAProjectileSimulationSubsystem instead of the movement component and overlaps
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile")
+		bool bUseSimulationManager = true;
+
+	// Character owned skillshots normally stop colliding while simulated, their hits come through OnTargetReached.
+	// Keep collision on for Blueprints that still handle the projectile's own overlaps.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile")
+		bool bKeepCollisionWhenSimulated = false;
+
+	// Slot in UMOBAProjectileSimulationSubsystem while simulated. Owned by the subsystem.
+	int32 SimulationIndex = INDEX_NONE;
+
+	// Changes every time the projectile is initialized, so a pooled actor's old flight can be told from its new one
+	uint32 FlightId = 0;
+
 	// Sphere collision component.
 	UPROPERTY(VisibleDefaultsOnly, Category = Projectile)
 		USphereComponent* CollisionComponent;
@@ -58,6 +124,29 @@ public:
 
 	UFUNCTION(BlueprintImplementableEvent)
 		void OnTargetReached(ACharacter* InTarget);
+
+	// Record the hit and call OnTargetReached. Net proxies only record it.
+	void ReachTarget(ACharacter* InTarget);
+
+	// Broadcast once per flight when the projectile hits its target or expires, before it is pooled or destroyed
+	UPROPERTY(BlueprintAssignable, Category = "Projectile")
+		FProjectileResolved OnProjectileResolved;
+
+	// End this flight. Pooled projectiles go back to their pool, others are destroyed. Does nothing once the projectile is parked or destroyed.
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+		void ResolveProjectile(bool bHitTarget);
+
+	// Clear flight state so a pooled projectile can be initialized again
+	void ResetProjectile();
+
+	// Show, collide and move, or park the projectile in its pool
+	void SetPooledActive(bool bActive);
+
+	// Pool this projectile returns to on resolve, null for projectiles that were spawned directly
+	TWeakObjectPtr<UMOBAProjectilePoolSubsystem> OwningPool;
+
+	// Waiting in its pool's Available list. Set and cleared by UMOBAProjectilePoolSubsystem.
+	bool bIsParked = false;
 	
 	UFUNCTION(BlueprintCallable)
 		void InitializeProjectile(bool IsSingleTarget, ACharacter* CharacterTarget = NULL, FVector Direction = FVector(0,0,0), float InMaxDistance = 0.0f);